@@ -0,0 +1,6 @@
+#!/bin/bash
+
+g++ -std=c++11 -O2 -pthread benchmark_101206884_101211245.cpp -o benchmark
+
+# run the benchmarks
+./benchmark
@@ -0,0 +1,437 @@
+#define SIMULATOR_NO_MAIN
+#include "interrupts_101206884_101211245.cpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace bench {
+    struct Result {
+        std::string benchmark; // what was measured
+        std::string variant;   // scheduler, engine or data structure
+        size_t size;           // number of processes or partitions
+        std::string unit;      // unit of value
+        double value;          // measured value
+    };
+
+    std::vector<Result> results; // every measurement, written to the csv at the end
+    volatile long sink;          // timed results are stored here so the compiler cannot drop the work
+    const char* const discard = "/dev/null"; // trace output of the benchmarked simulators, so real run outputs are never overwritten
+
+    // records a measurement and prints it
+    void record(const std::string& benchmark, const std::string& variant, size_t size, const std::string& unit, double value) {
+        results.push_back({benchmark, variant, size, unit, value});
+        std::cout << std::setw(22) << std::left << benchmark << std::setw(14) << variant
+                  << std::setw(10) << size << value << " " << unit << "\n";
+    }
+
+    // writes all measurements as csv so runs can be compared between versions
+    void writeResults(const std::string& filename) {
+        std::ofstream file(filename);
+        file << "benchmark,variant,size,unit,value\n";
+        for (const auto& result : results) {
+            file << result.benchmark << "," << result.variant << "," << result.size << ","
+                 << result.unit << "," << std::setprecision(10) << result.value << "\n";
+        }
+    }
+
+    // ns elapsed while running fn
+    template <typename Function>
+    double elapsedNs(Function fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    // the PCB layout before the hot/cold split, scheduling fields interleaved with the name and statistics
+    struct LegacyPCB {
+        unsigned int pid;
+        std::string programName;
+        unsigned int arrivalTime;
+        unsigned int totalCPUTime;
+        unsigned int remainingCPUTime;
+        unsigned int ioFrequency;
+        unsigned int initialIOFrequency;
+        unsigned int ioDuration;
+        unsigned int initialIODuration;
+        unsigned int nextIOTime;
+        unsigned int partitionNumber;
+        ProcessState state;
+        unsigned int size;
+        unsigned int priority;
+        unsigned int lastScheduledTime;
+        unsigned int totalWaitTime;
+        unsigned int readySince;
+        unsigned int startTime;
+        unsigned int finishTime;
+        unsigned int responseTime;
+        bool hasStarted;
+        unsigned int totalIOTime;
+        unsigned int ioStartTime;
+        unsigned int wakeTime;
+        unsigned long timerOrder;
+        unsigned int numberOfIO;
+        unsigned int core;
+        unsigned int level;
+        unsigned long long vruntime;
+        LegacyPCB* prevInQueue;
+        LegacyPCB* nextInQueue;
+    };
+
+    // counts the cache misses of this thread with perf_event_open, unavailable where there are no hardware counters
+    class CacheMissCounter {
+    private:
+        int fd; // perf event file descriptor, -1 if unavailable
+
+    public:
+        CacheMissCounter() {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+
+        ~CacheMissCounter() {
+            if (fd >= 0) close(fd);
+        }
+
+        bool available() const { return fd >= 0; }
+
+        void start() {
+            if (fd < 0) return;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+
+        // misses since start, 0 if unavailable
+        long long stop() {
+            long long misses = 0;
+            if (fd < 0) return misses;
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &misses, sizeof(misses)) != sizeof(misses)) misses = 0;
+            return misses;
+        }
+    };
+
+    // one scheduling step on each process in the given order, touching the fields dispatch and run touch
+    template <typename Process>
+    long touchProcesses(std::vector<Process>& pcbs, const std::vector<unsigned int>& order) {
+        long work = 0;
+        for (unsigned int i : order) {
+            Process& pcb = pcbs[i];
+            pcb.state = RUNNING;
+            pcb.remainingCPUTime--;
+            if (--pcb.nextIOTime == 0) {
+                pcb.nextIOTime = pcb.ioFrequency;
+                pcb.state = WAITING;
+            }
+            work += pcb.priority + pcb.core;
+        }
+        return work;
+    }
+
+    // creates n processes with random priorities and remaining cpu times
+    std::vector<PCB> makeProcesses(size_t n, std::mt19937& gen) {
+        std::uniform_int_distribution<unsigned int> priorityDistr(0, 63);
+        std::uniform_int_distribution<unsigned int> cpuDistr(1, 2000);
+        std::vector<PCB> pcbs(n);
+        for (size_t i = 0; i < n; i++) {
+            pcbs[i].pid = i + 1;
+            pcbs[i].priority = priorityDistr(gen);
+            pcbs[i].remainingCPUTime = cpuDistr(gen);
+            pcbs[i].vruntime = 0;
+        }
+        return pcbs;
+    }
+
+    // writes a workload of n processes that fit the default partitions
+    void writeWorkload(const std::string& filename, size_t n, std::mt19937& gen) {
+        std::uniform_int_distribution<unsigned int> sizeDistr(1, 40);
+        std::uniform_int_distribution<unsigned int> cpuDistr(1, 2000);
+        std::uniform_int_distribution<unsigned int> ioFrequencyDistr(1, 300);
+        std::uniform_int_distribution<unsigned int> ioDurationDistr(1, 50);
+        std::uniform_int_distribution<unsigned int> priorityDistr(0, 9);
+        std::uniform_int_distribution<unsigned int> gapDistr(0, 200);
+
+        TraceWriter out;
+        out.open(filename);
+        unsigned int arrival = 0;
+        for (size_t pid = 1; pid <= n; pid++) {
+            char* row = out.reserve(96);
+            int length = std::snprintf(row, 96, "%zu, %u, %u, %u, %u, %u, %u\n", pid, sizeDistr(gen), arrival,
+                                       cpuDistr(gen), ioFrequencyDistr(gen), ioDurationDistr(gen), priorityDistr(gen));
+            out.commit(length);
+            arrival += gapDistr(gen);
+        }
+    }
+}
+
+class SimulatorBenchmark {
+public:
+    // ns per best fit lookup with half of the partitions taken
+    static void bestFit(size_t partitions, std::mt19937& gen) {
+        std::uniform_int_distribution<unsigned int> sizeDistr(1, 1000);
+        std::vector<unsigned int> sizes(partitions);
+        for (auto& size : sizes) size = sizeDistr(gen);
+
+        OSSimulator simulator(bench::discard, bench::discard);
+        simulator.setPartitionSizes(sizes);
+        std::vector<PCB> pcbs = bench::makeProcesses(partitions / 2, gen);
+        for (size_t i = 0; i < pcbs.size(); i++) {
+            simulator.allocatePartition(i * 2, &pcbs[i]);
+        }
+
+        const size_t lookups = 200000;
+        std::vector<unsigned int> requests(lookups);
+        for (auto& request : requests) request = sizeDistr(gen);
+
+        long found = 0;
+        double ns = bench::elapsedNs([&]() {
+            for (auto request : requests) found += simulator.findBestFitPartition(request);
+        });
+        bench::sink = found;
+        bench::record("findBestFitPartition", "set", partitions, "ns/lookup", ns / lookups);
+    }
+
+    // ns per dispatch with n processes in the ready queue, the process goes back to the queue after running
+    static void dispatch(const std::string& scheduler, size_t n, std::mt19937& gen) {
+        std::vector<PCB> pcbs = bench::makeProcesses(n, gen);
+        ReadyQueue queue;
+        bool keyed = scheduler != "FCFS" && scheduler != "RR" && scheduler != "MLFQ";
+        bool leveled = scheduler == "MLFQ";
+        bool fairShare = scheduler == "CFS";
+        auto key = [&](const PCB& pcb) -> unsigned long long {
+            if (leveled) return pcb.priority % 3;
+            if (fairShare) return pcb.vruntime;
+            if (!keyed) return 0;
+            return scheduler == "EP" ? pcb.priority : pcb.remainingCPUTime;
+        };
+        queue.setKeyed(keyed);
+        queue.setLevels(leveled ? 3 : 1);
+        for (auto& pcb : pcbs) queue.push(&pcb, key(pcb));
+
+        const size_t decisions = 200000;
+        double ns = bench::elapsedNs([&]() {
+            for (size_t i = 0; i < decisions; i++) {
+                PCB* pcb = queue.pop();
+                if (fairShare) pcb->vruntime += fair::vruntimePerMs(pcb->priority);
+                queue.push(pcb, key(*pcb));
+            }
+        });
+        bench::record("dispatch", scheduler, n, "ns/decision", ns / decisions);
+    }
+
+    // ns per EP decision for the linear scan the EP scheduler used before ReadyQueue
+    static void linearScanDispatch(size_t n, std::mt19937& gen) {
+        std::vector<PCB> pcbs = bench::makeProcesses(n, gen);
+        std::vector<PCB*> queue;
+        for (auto& pcb : pcbs) queue.push_back(&pcb);
+
+        const size_t decisions = std::max<size_t>(100, 20000000 / n);
+        double ns = bench::elapsedNs([&]() {
+            for (size_t i = 0; i < decisions; i++) {
+                auto highestPriority = std::min_element(queue.begin(), queue.end(),
+                    [](PCB* a, PCB* b) { return a->priority < b->priority; });
+                PCB* next = *highestPriority;
+                queue.erase(highestPriority);
+                queue.push_back(next);
+            }
+        });
+        bench::record("dispatch", "EP-linear", n, "ns/decision", ns / decisions);
+    }
+
+    // ns per tick spent finding io completions with n processes blocked on io, each restarting io when it completes
+    static void ioCompletions(size_t n, std::mt19937& gen) {
+        std::uniform_int_distribution<unsigned int> durationDistr(1, 5000);
+        std::vector<PCB> pcbs = bench::makeProcesses(n, gen);
+        for (auto& pcb : pcbs) pcb.ioDuration = durationDistr(gen);
+        const unsigned int ticks = std::max<size_t>(1000, 20000000 / n);
+
+        TimerWheel wheel;
+        std::vector<PCB*> woken;
+        for (auto& pcb : pcbs) wheel.schedule(&pcb, pcb.ioDuration);
+        long completed = 0;
+        double ns = bench::elapsedNs([&]() {
+            for (unsigned int t = 1; t <= ticks; t++) {
+                wheel.advance(t, woken);
+                for (PCB* pcb : woken) wheel.schedule(pcb, t + pcb->ioDuration);
+                completed += woken.size();
+            }
+        });
+        bench::record("ioCompletions", "timer-wheel", n, "ns/tick", ns / ticks);
+
+        // the per tick countdown over the whole waiting queue used before the timer wheel
+        ProcessList waiting;
+        for (auto& pcb : pcbs) {
+            pcb.nextIOTime = pcb.ioDuration;
+            waiting.pushBack(&pcb);
+        }
+        ns = bench::elapsedNs([&]() {
+            for (unsigned int t = 1; t <= ticks; t++) {
+                for (PCB* pcb = waiting.front(); pcb != nullptr; pcb = pcb->nextInQueue) {
+                    if (--pcb->nextIOTime == 0) {
+                        pcb->nextIOTime = pcb->ioDuration;
+                        completed++;
+                    }
+                }
+            }
+        });
+        bench::sink = completed;
+        bench::record("ioCompletions", "list-walk", n, "ns/tick", ns / ticks);
+    }
+
+    // ns and cache misses per scheduling step on n processes visited in random order, old PCB layout against the hot PCB
+    template <typename Process>
+    static void pcbLayout(const std::string& variant, size_t n, std::mt19937& gen) {
+        std::vector<Process> pcbs(n);
+        for (auto& pcb : pcbs) {
+            pcb.state = READY;
+            pcb.remainingCPUTime = UINT_MAX;
+            pcb.ioFrequency = 1000;
+            pcb.nextIOTime = 1000;
+            pcb.priority = 0;
+            pcb.core = 0;
+        }
+        std::vector<unsigned int> order(n);
+        for (size_t i = 0; i < n; i++) order[i] = i;
+        std::shuffle(order.begin(), order.end(), gen);
+
+        const size_t passes = std::max<size_t>(1, 20000000 / n);
+        bench::CacheMissCounter counter;
+        long work = 0;
+        counter.start();
+        double ns = bench::elapsedNs([&]() {
+            for (size_t pass = 0; pass < passes; pass++) work += bench::touchProcesses(pcbs, order);
+        });
+        long long misses = counter.stop();
+        bench::sink = work;
+
+        bench::record("pcbLayout", variant, n, "ns/process", ns / (passes * n));
+        bench::record("pcbLayout", variant, n, "bytes/process", sizeof(Process));
+        if (counter.available()) {
+            bench::record("pcbLayout", variant, n, "cache misses/process", static_cast<double>(misses) / (passes * n));
+        }
+    }
+
+    // ns per execution table row
+    static void logStateTransition() {
+        OSSimulator simulator(bench::discard, bench::discard);
+        const size_t rows = 500000;
+        double ns = bench::elapsedNs([&]() {
+            for (size_t i = 0; i < rows; i++) simulator.logStateTransition(i, i % 1000, READY, RUNNING);
+            simulator.saveExecution();
+        });
+        bench::record("logStateTransition", "text", 0, "ns/row", ns / rows);
+    }
+
+    // ns per memory status row with the given number of partitions, half of them taken
+    static void saveMemoryStatus(size_t partitions, std::mt19937& gen) {
+        OSSimulator simulator(bench::discard, bench::discard);
+        simulator.setPartitionSizes(std::vector<unsigned int>(partitions, 10));
+        std::vector<PCB> pcbs = bench::makeProcesses(partitions / 2, gen);
+        for (size_t i = 0; i < pcbs.size(); i++) {
+            simulator.allocatePartition(i * 2, &pcbs[i]);
+        }
+
+        const size_t rows = std::max<size_t>(100, 2000000 / partitions);
+        double ns = bench::elapsedNs([&]() {
+            for (size_t i = 0; i < rows; i++) simulator.saveMemoryStatus(i);
+            simulator.saveMemoryStatus();
+        });
+        bench::record("saveMemoryStatus", "text", partitions, "ns/row", ns / rows);
+    }
+
+    // parse throughput of loadProcesses
+    static void loadProcesses(const std::string& workload, size_t n) {
+        OSSimulator simulator(bench::discard, bench::discard);
+        simulator.loadProcesses(workload);
+        bench::record("loadProcesses", "mmap", n, "MB/s", simulator.loadedBytes / 1e6 / simulator.loadSeconds);
+    }
+
+    // simulated ms per wall second and ns per scheduling decision for a whole run
+    static void simulate(const std::string& workload, size_t n, const std::string& scheduler, bool eventDriven) {
+        OSSimulator simulator(bench::discard, bench::discard);
+        simulator.setEventDriven(eventDriven);
+        simulator.loadProcesses(workload);
+        double ns = bench::elapsedNs([&]() {
+            simulator.simulate(scheduler);
+            simulator.saveExecution();
+            simulator.saveMemoryStatus();
+        });
+        std::string variant = scheduler + (eventDriven ? "-event" : "-tick");
+        bench::record("simulate", variant, n, "simulated ms/s", simulator.currentTime / (ns / 1e9));
+        bench::record("simulate", variant, n, "ns/decision", simulator.dispatches ? ns / simulator.dispatches : 0);
+        if (!eventDriven) {
+            bench::record("simulate", variant, n, "ns/tick", simulator.currentTime ? ns / simulator.currentTime : 0);
+        }
+    }
+};
+
+int main(int argc, char** argv) {
+    size_t maxProcesses = 100000;
+    size_t maxSimulated = 1000;
+    std::string output = "benchmark_results.csv";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--max-processes") {
+            maxProcesses = std::stoul(argv[i + 1]);
+        } else if (arg == "--max-simulated") {
+            maxSimulated = std::stoul(argv[i + 1]);
+        } else if (arg == "--output") {
+            output = argv[i + 1];
+        }
+    }
+
+    std::mt19937 gen(12345);
+    const std::string schedulers[] = {"FCFS", "EP", "RR", "SJF", "SRTF", "MLFQ", "CFS"};
+
+    for (size_t partitions = 6; partitions <= 60000; partitions *= 10) {
+        SimulatorBenchmark::bestFit(partitions, gen);
+    }
+
+    for (size_t n = 10; n <= maxProcesses; n *= 10) {
+        for (const auto& scheduler : schedulers) {
+            SimulatorBenchmark::dispatch(scheduler, n, gen);
+        }
+        if (n <= 100000) {
+            SimulatorBenchmark::linearScanDispatch(n, gen);
+        }
+    }
+
+    for (size_t n = 10; n <= maxProcesses; n *= 10) {
+        SimulatorBenchmark::ioCompletions(n, gen);
+    }
+
+    for (size_t n = 1000; n <= maxProcesses; n *= 10) {
+        SimulatorBenchmark::pcbLayout<bench::LegacyPCB>("legacy-pcb", n, gen);
+        SimulatorBenchmark::pcbLayout<PCB>("hot-pcb", n, gen);
+    }
+
+    SimulatorBenchmark::logStateTransition();
+    for (size_t partitions = 6; partitions <= 6000; partitions *= 10) {
+        SimulatorBenchmark::saveMemoryStatus(partitions, gen);
+    }
+
+    const std::string workload = "benchmark_workload.txt";
+    for (size_t n = 10; n <= maxProcesses; n *= 10) {
+        bench::writeWorkload(workload, n, gen);
+        SimulatorBenchmark::loadProcesses(workload, n);
+        if (n > maxSimulated) continue;
+        for (const auto& scheduler : schedulers) {
+            SimulatorBenchmark::simulate(workload, n, scheduler, false);
+            SimulatorBenchmark::simulate(workload, n, scheduler, true);
+        }
+    }
+    std::remove(workload.c_str());
+
+    bench::writeResults(output);
+    std::cout << "Results written to " << output << "\n";
+    return 0;
+}
@@ -21,4 +21,11 @@ rm -f input_data_7.txt
 rm -f input_data_8.txt
 rm -f input_data_9.txt
 rm -f input_data_10.txt
-rm -f simulator
\ No newline at end of file
+rm -f simulator
+rm -f benchmark
+rm -f trace_convert
+rm -f execution.bin
+rm -f memory_status.bin
+rm -f workload_generator
+rm -f benchmark_results.csv
+rm -f sweep
\ No newline at end of file
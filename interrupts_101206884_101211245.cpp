@@ -1,5 +1,13 @@
 #include "interrupts_101206884_101211245.hpp"
 
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace utils {
     std::string trim(const std::string& str) {
         size_t first = str.find_first_not_of(" \t\n\r");
@@ -28,6 +36,600 @@ namespace utils {
         ss << "0x" << std::setfill('0') << std::setw(4) << std::hex << std::uppercase << value;
         return ss.str();
     }
+
+    int parseInt(const char* begin, const char* end) {
+        const char* p = begin;
+        while (p < end && std::isspace(static_cast<unsigned char>(*p))) p++;
+
+        bool negative = false;
+        if (p < end && (*p == '+' || *p == '-')) {
+            negative = *p == '-';
+            p++;
+        }
+
+        const char* digits = p;
+        long long value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p - '0');
+            if (value > static_cast<long long>(INT_MAX) + 1) throw std::out_of_range("stoi");
+            p++;
+        }
+        if (p == digits) throw std::invalid_argument("stoi");
+
+        if (negative) value = -value;
+        if (value > INT_MAX) throw std::out_of_range("stoi");
+        return static_cast<int>(value);
+    }
+}
+
+ProcessList::ProcessList() : head(nullptr), tail(nullptr), count(0) {}
+
+void ProcessList::pushBack(PCB* pcb) {
+    pcb->prevInQueue = tail;
+    pcb->nextInQueue = nullptr;
+    if (tail != nullptr) {
+        tail->nextInQueue = pcb;
+    } else {
+        head = pcb;
+    }
+    tail = pcb;
+    count++;
+}
+
+PCB* ProcessList::popFront() {
+    PCB* pcb = head;
+    if (pcb != nullptr) remove(pcb);
+    return pcb;
+}
+
+void ProcessList::remove(PCB* pcb) {
+    if (pcb->prevInQueue != nullptr) {
+        pcb->prevInQueue->nextInQueue = pcb->nextInQueue;
+    } else {
+        head = pcb->nextInQueue;
+    }
+    if (pcb->nextInQueue != nullptr) {
+        pcb->nextInQueue->prevInQueue = pcb->prevInQueue;
+    } else {
+        tail = pcb->prevInQueue;
+    }
+    pcb->prevInQueue = nullptr;
+    pcb->nextInQueue = nullptr;
+    count--;
+}
+
+void ProcessList::append(ProcessList& other) {
+    if (other.head == nullptr) return;
+    if (tail != nullptr) {
+        tail->nextInQueue = other.head;
+        other.head->prevInQueue = tail;
+    } else {
+        head = other.head;
+    }
+    tail = other.tail;
+    count += other.count;
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.count = 0;
+}
+
+PCB* ProcessList::front() const {
+    return head;
+}
+
+bool ProcessList::empty() const {
+    return count == 0;
+}
+
+size_t ProcessList::size() const {
+    return count;
+}
+
+constexpr unsigned int ReadyQueue::MAX_LEVELS;
+
+constexpr unsigned int TimerWheel::SLOT_BITS;
+constexpr unsigned int TimerWheel::SLOTS;
+constexpr unsigned int TimerWheel::LEVELS;
+
+TimerWheel::TimerWheel() : slots(LEVELS * SLOTS), now(0), nextOrder(0), count(0) {}
+
+void TimerWheel::place(PCB* pcb) {
+    unsigned int level = (31 - __builtin_clz(pcb->wakeTime ^ now)) / SLOT_BITS;
+    unsigned int slot = (pcb->wakeTime >> (level * SLOT_BITS)) & (SLOTS - 1);
+    slots[level * SLOTS + slot].pushBack(pcb);
+}
+
+void TimerWheel::schedule(PCB* pcb, unsigned int wakeTime) {
+    pcb->wakeTime = wakeTime;
+    pcb->timerOrder = nextOrder++;
+    place(pcb);
+    count++;
+}
+
+void TimerWheel::advance(unsigned int time, std::vector<PCB*>& woken) {
+    woken.clear();
+    if (time == now) return;
+
+    // processes in the slot of the highest group that changed now share every higher group with time
+    unsigned int level = (31 - __builtin_clz(time ^ now)) / SLOT_BITS;
+    now = time;
+    if (level > 0) {
+        ProcessList& slot = slots[level * SLOTS + ((time >> (level * SLOT_BITS)) & (SLOTS - 1))];
+        while (PCB* pcb = slot.popFront()) {
+            if (pcb->wakeTime == time) {
+                woken.push_back(pcb);
+            } else {
+                place(pcb);
+            }
+        }
+    }
+    ProcessList& slot = slots[time & (SLOTS - 1)];
+    while (PCB* pcb = slot.popFront()) {
+        woken.push_back(pcb);
+    }
+
+    std::sort(woken.begin(), woken.end(), [](const PCB* a, const PCB* b) { return a->timerOrder < b->timerOrder; });
+    count -= woken.size();
+}
+
+bool TimerWheel::empty() const {
+    return count == 0;
+}
+
+size_t TimerWheel::size() const {
+    return count;
+}
+
+constexpr unsigned int BuddyAllocator::ORDERS;
+
+BuddyAllocator::BuddyAllocator() : freeBlocks(ORDERS), allocatedBlocks(ORDERS, 0), total(0), allocated(0), requested(0) {}
+
+void BuddyAllocator::reset(unsigned int totalSize) {
+    blocks.clear();
+    freeBlocks.assign(ORDERS, std::set<unsigned int>());
+    allocatedBlocks.assign(ORDERS, 0);
+    total = totalSize;
+    allocated = 0;
+    requested = 0;
+
+    // largest blocks first keeps every block aligned to its size
+    unsigned int offset = 0;
+    for (unsigned int order = ORDERS; order-- > 0;) {
+        if (totalSize & (1u << order)) {
+            addFree(offset, order);
+            offset += 1u << order;
+        }
+    }
+}
+
+unsigned int BuddyAllocator::orderFor(unsigned int size) {
+    return size <= 1 ? 0 : 32 - __builtin_clz(size - 1);
+}
+
+unsigned int BuddyAllocator::largestFree() const {
+    for (unsigned int order = ORDERS; order-- > 0;) {
+        if (!freeBlocks[order].empty()) return 1u << order;
+    }
+    return 0;
+}
+
+unsigned int BuddyAllocator::largestFreeAfterCompaction() const {
+    // replays compact on block counts: largest blocks first, each into the smallest free block that holds it
+    std::vector<unsigned long long> freeCount(ORDERS, 0);
+    for (unsigned int order = 0; order < ORDERS; order++) {
+        if (total & (1u << order)) freeCount[order] = 1;
+    }
+    for (unsigned int order = ORDERS; order-- > 0;) {
+        unsigned long long remaining = allocatedBlocks[order];
+        while (remaining > 0) {
+            if (freeCount[order] > 0) {
+                unsigned long long taken = std::min(remaining, freeCount[order]);
+                freeCount[order] -= taken;
+                remaining -= taken;
+                continue;
+            }
+            unsigned int split = order + 1;
+            while (split < ORDERS && freeCount[split] == 0) split++;
+            if (split == ORDERS) return 0;
+
+            // the blocks fill the split block from its lowest address, what is left above them stays in aligned blocks
+            freeCount[split]--;
+            unsigned long long capacity = 1ULL << (split - order);
+            unsigned long long taken = std::min(remaining, capacity);
+            remaining -= taken;
+            for (unsigned int bit = 0; bit < split - order; bit++) {
+                if ((capacity - taken) & (1ULL << bit)) freeCount[order + bit]++;
+            }
+        }
+    }
+    for (unsigned int order = ORDERS; order-- > 0;) {
+        if (freeCount[order] > 0) return 1u << order;
+    }
+    return 0;
+}
+
+void BuddyAllocator::addFree(unsigned int offset, unsigned int order) {
+    blocks[offset] = {order, nullptr};
+    freeBlocks[order].insert(offset);
+}
+
+bool BuddyAllocator::allocateOrder(unsigned int order, PCB* pcb, unsigned int& offset) {
+    unsigned int found = order;
+    while (found < ORDERS && freeBlocks[found].empty()) found++;
+    if (found == ORDERS) return false;
+
+    offset = *freeBlocks[found].begin();
+    freeBlocks[found].erase(freeBlocks[found].begin());
+    // keep the lower half, the upper halves become free buddies
+    while (found > order) {
+        found--;
+        addFree(offset + (1u << found), found);
+    }
+    blocks[offset] = {order, pcb};
+    allocated += 1u << order;
+    allocatedBlocks[order]++;
+    return true;
+}
+
+bool BuddyAllocator::allocate(PCB* pcb, unsigned int& offset) {
+    unsigned int order = orderFor(pcb->size);
+    if (order >= ORDERS || !allocateOrder(order, pcb, offset)) return false;
+    requested += pcb->size;
+    return true;
+}
+
+void BuddyAllocator::release(unsigned int offset) {
+    auto it = blocks.find(offset);
+    unsigned int order = it->second.order;
+    allocated -= 1u << order;
+    allocatedBlocks[order]--;
+    requested -= it->second.owner->size;
+    blocks.erase(it);
+
+    while (order + 1 < ORDERS) {
+        unsigned int buddy = offset ^ (1u << order);
+        if (freeBlocks[order].erase(buddy) == 0) break;
+        blocks.erase(buddy);
+        offset = std::min(offset, buddy);
+        order++;
+    }
+    addFree(offset, order);
+}
+
+unsigned long BuddyAllocator::compact() {
+    struct Moving {
+        unsigned int offset;
+        unsigned int order;
+        PCB* owner;
+    };
+    std::vector<Moving> moving;
+    for (const auto& block : blocks) {
+        if (block.second.owner != nullptr) moving.push_back({block.first, block.second.order, block.second.owner});
+    }
+    std::stable_sort(moving.begin(), moving.end(), [](const Moving& a, const Moving& b) { return a.order > b.order; });
+
+    // placing the largest blocks first packs them from address 0 without gaps
+    unsigned int owned = requested;
+    reset(total);
+    requested = owned;
+    unsigned long moved = 0;
+    for (const auto& block : moving) {
+        unsigned int offset;
+        allocateOrder(block.order, block.owner, offset);
+        if (offset != block.offset) {
+            moved += 1u << block.order;
+            block.owner->partitionNumber = offset;
+        }
+    }
+    return moved;
+}
+
+ReadyQueue::ReadyQueue() : levels(1), occupiedLevels(0), levelCount(0), keyed(false), nextOrder(0) {}
+
+bool ReadyQueue::runsAfter(const Entry& a, const Entry& b) {
+    if (a.key != b.key) return a.key > b.key;
+    return a.order > b.order;
+}
+
+void ReadyQueue::setKeyed(bool enabled) {
+    keyed = enabled;
+}
+
+void ReadyQueue::setLevels(unsigned int count) {
+    levels.assign(std::min(std::max(1u, count), MAX_LEVELS), ProcessList());
+}
+
+void ReadyQueue::push(PCB* pcb, unsigned long long key) {
+    if (keyed) {
+        entries.push_back({key, nextOrder++, pcb});
+        std::push_heap(entries.begin(), entries.end(), runsAfter);
+    } else {
+        levels[key].pushBack(pcb);
+        occupiedLevels |= uint64_t(1) << key;
+        levelCount++;
+    }
+}
+
+PCB* ReadyQueue::pop() {
+    if (!keyed) {
+        if (occupiedLevels == 0) return nullptr;
+        unsigned int level = __builtin_ctzll(occupiedLevels);
+        PCB* pcb = levels[level].popFront();
+        if (levels[level].empty()) occupiedLevels &= ~(uint64_t(1) << level);
+        levelCount--;
+        return pcb;
+    }
+    if (entries.empty()) return nullptr;
+
+    std::pop_heap(entries.begin(), entries.end(), runsAfter);
+    PCB* pcb = entries.back().pcb;
+    entries.pop_back();
+    return pcb;
+}
+
+unsigned long long ReadyQueue::topKey() const {
+    return keyed ? entries.front().key : __builtin_ctzll(occupiedLevels);
+}
+
+void ReadyQueue::mergeLevels() {
+    for (size_t level = 1; level < levels.size(); level++) {
+        for (PCB* pcb = levels[level].front(); pcb != nullptr; pcb = pcb->nextInQueue) pcb->level = 0;
+        levels[0].append(levels[level]);
+    }
+    if (occupiedLevels != 0) occupiedLevels = 1;
+}
+
+bool ReadyQueue::empty() const {
+    return keyed ? entries.empty() : levelCount == 0;
+}
+
+size_t ReadyQueue::size() const {
+    return keyed ? entries.size() : levelCount;
+}
+
+constexpr size_t TraceWriter::BUFFER_SIZE;
+
+TraceWriter::TraceWriter() : buffer(BUFFER_SIZE), used(0) {}
+
+TraceWriter::~TraceWriter() {
+    flush();
+}
+
+bool TraceWriter::open(const std::string& filename) {
+    if (file.is_open()) {
+        flush();
+        file.close();
+    }
+    used = 0;
+    file.open(filename, std::ios::trunc);
+    return file.is_open();
+}
+
+void TraceWriter::write(const char* data, size_t length) {
+    if (length > BUFFER_SIZE - used) {
+        flush();
+        if (length > BUFFER_SIZE) {
+            file.write(data, length);
+            return;
+        }
+    }
+    std::copy(data, data + length, buffer.begin() + used);
+    used += length;
+}
+
+void TraceWriter::write(const char* text) {
+    write(text, std::strlen(text));
+}
+
+char* TraceWriter::reserve(size_t length) {
+    if (length > BUFFER_SIZE - used) flush();
+    return &buffer[used];
+}
+
+void TraceWriter::commit(size_t length) {
+    used += length;
+}
+
+void TraceWriter::flush() {
+    if (used > 0 && file.is_open()) {
+        file.write(&buffer[0], used);
+    }
+    used = 0;
+    file.flush();
+}
+
+namespace fair {
+    unsigned int weight(unsigned int priority) {
+        static const unsigned int weights[] = {1024, 820, 655, 526, 423, 335, 272, 215, 172, 137,
+                                               110, 87, 70, 56, 45, 36, 29, 23, 18, 15};
+        return weights[std::min(priority, 19u)];
+    }
+
+    unsigned long long vruntimePerMs(unsigned int priority) {
+        return 1000ULL * weight(0) / weight(priority);
+    }
+}
+
+constexpr unsigned int SchedulingPolicy::NO_QUANTUM;
+
+void MLFQPolicy::onQuantumExpired(PCB& pcb, const SchedulerSettings& settings) {
+    if (pcb.level + 1 < settings.levelQuanta.size()) pcb.level++;
+}
+
+void MLFQPolicy::onPeriod(std::vector<Core>& cores, TimerWheel& sleeping) {
+    // new processes are still at level 0, so only queued, running and sleeping ones need a reset
+    for (auto& core : cores) {
+        core.readyQueue.mergeLevels();
+        if (core.runningProcess != nullptr) core.runningProcess->level = 0;
+        core.currentTimeSlice = 0;
+    }
+    sleeping.forEach([](PCB* pcb) { pcb->level = 0; });
+}
+
+void CFSPolicy::onReady(Core& core, PCB& pcb) {
+    // new and waking processes start at the core's minimum instead of catching up on the time they were away
+    unsigned long long lowest = ULLONG_MAX;
+    if (core.runningProcess != nullptr) lowest = core.runningProcess->vruntime;
+    if (!core.readyQueue.empty()) lowest = std::min(lowest, core.readyQueue.topKey());
+    if (lowest != ULLONG_MAX) core.minVruntime = std::max(core.minVruntime, lowest);
+    pcb.vruntime = std::max(pcb.vruntime, core.minVruntime);
+    core.readyWeight += fair::weight(pcb.priority);
+}
+
+unsigned int CFSPolicy::quantum(const Core& core, const SchedulerSettings& settings) {
+    // the quantum only ends when another process is waiting for the core
+    if (core.readyQueue.empty()) return NO_QUANTUM;
+
+    // the target latency is shared between the runnable processes in proportion to their weights
+    unsigned long long weight = fair::weight(core.runningProcess->priority);
+    unsigned long long slice = settings.targetLatency * weight / (weight + core.readyWeight);
+    return std::max<unsigned long long>(settings.minGranularity, slice);
+}
+
+namespace tables {
+    char* writeUnsigned(char* out, unsigned int value) {
+        char digits[10];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (count > 0) *out++ = digits[--count];
+        return out;
+    }
+
+    char* writeInt(char* out, int value) {
+        if (value < 0) {
+            *out++ = '-';
+            return writeUnsigned(out, 0u - static_cast<unsigned int>(value));
+        }
+        return writeUnsigned(out, value);
+    }
+
+    char* writeText(char* out, const char* text) {
+        while (*text != '\0') *out++ = *text++;
+        return out;
+    }
+
+    char* padColumn(char* start, char* end, size_t width) {
+        while (static_cast<size_t>(end - start) < width) *end++ = ' ';
+        return end;
+    }
+
+    void writeExecutionHeader(TraceWriter& out) {
+        out.write("+--------------------+-----+-------------+------------+\n"
+                  "| Time of Transition | PID |  Old State  | New State  |\n"
+                  "+--------------------+-----+-------------+------------+\n");
+    }
+
+    void writeExecutionRow(TraceWriter& out, unsigned int time, unsigned int pid, ProcessState oldState, ProcessState newState) {
+        // widest row: two 10 digit numbers and TERMINATED in both state columns
+        char* row = out.reserve(80);
+        char* end = writeText(row, "| ");
+        end = padColumn(end, writeUnsigned(end, time), 18);
+        end = writeText(end, " | ");
+        end = padColumn(end, writeUnsigned(end, pid), 3);
+        end = writeText(end, " | ");
+        end = padColumn(end, writeText(end, stateName(oldState)), 11);
+        end = writeText(end, " | ");
+        end = padColumn(end, writeText(end, stateName(newState)), 10);
+        end = writeText(end, " |\n");
+        out.commit(end - row);
+    }
+
+    void writeExecutionFooter(TraceWriter& out) {
+        out.write("+--------------------+-----+-------------+------------+\n");
+    }
+
+    void writeMemoryStatusHeader(TraceWriter& out) {
+        out.write("+------------+------------+---------------------------+-------------------+-------------------+\n"
+                  "| Time Event | Memory Used|   Partitions State        | Total Free Memory | Usable Free Memory|\n"
+                  "+------------+------------+---------------------------+-------------------+-------------------+\n");
+    }
+
+    void writeMemoryStatusStart(TraceWriter& out, unsigned int time, unsigned int memoryUsed) {
+        char* row = out.reserve(32);
+        char* end = writeText(row, "| ");
+        end = padColumn(end, writeUnsigned(end, time), 10);
+        end = writeText(end, " | ");
+        end = padColumn(end, writeUnsigned(end, memoryUsed), 10);
+        end = writeText(end, " | ");
+        out.commit(end - row);
+    }
+
+    size_t writeMemoryStatusCell(TraceWriter& out, int pid, bool first) {
+        char* cell = out.reserve(16);
+        char* end = first ? cell : writeText(cell, ", ");
+        end = writeInt(end, pid);
+        out.commit(end - cell);
+        return end - cell;
+    }
+
+    void writeMemoryStatusEnd(TraceWriter& out, size_t partitionsLength, unsigned int totalFreeMemory, unsigned int usableFreeMemory) {
+        char* row = out.reserve(80);
+        char* end = row;
+        while (partitionsLength++ < 25) *end++ = ' ';
+        end = writeText(end, " | ");
+        end = padColumn(end, writeUnsigned(end, totalFreeMemory), 17);
+        end = writeText(end, " | ");
+        end = padColumn(end, writeUnsigned(end, usableFreeMemory), 17);
+        end = writeText(end, " |\n");
+        out.commit(end - row);
+    }
+
+    void writeMemoryStatusRow(TraceWriter& out, unsigned int time, unsigned int memoryUsed, const std::vector<int>& partitionsState,
+                              unsigned int totalFreeMemory, unsigned int usableFreeMemory) {
+        writeMemoryStatusStart(out, time, memoryUsed);
+        size_t partitionsLength = 0;
+        for (size_t i = 0; i < partitionsState.size(); i++) {
+            partitionsLength += writeMemoryStatusCell(out, partitionsState[i], i == 0);
+        }
+        writeMemoryStatusEnd(out, partitionsLength, totalFreeMemory, usableFreeMemory);
+    }
+
+    void writeMemoryStatusFooter(TraceWriter& out) {
+        out.write("+------------+------------+---------------------------+-------------------+-------------------+\n");
+    }
+}
+
+MappedFile::MappedFile() : bytes(nullptr), length(0) {}
+
+MappedFile::~MappedFile() {
+    if (bytes != nullptr) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+}
+
+bool MappedFile::open(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    length = info.st_size;
+    if (length > 0) {
+        void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            length = 0;
+            return false;
+        }
+        bytes = static_cast<const char*>(mapping);
+        madvise(mapping, length, MADV_SEQUENTIAL);
+    }
+    close(fd);
+    return true;
+}
+
+const char* MappedFile::data() const {
+    return bytes;
+}
+
+size_t MappedFile::size() const {
+    return length;
 }
 
 VectorTable::VectorTable(const std::string& filename) {
@@ -67,18 +669,47 @@ uint16_t VectorTable::getMemoryPosition(uint16_t interrupt_num) const {
 }
 
 OSSimulator::OSSimulator()
-    : nextPID(1), currentTime(0),
+    : OSSimulator("execution.txt", "memory_status.txt")
+{
+}
+
+OSSimulator::OSSimulator(const std::string& executionFile, const std::string& memoryStatusFile)
+    : nextArrival(0), terminatedCount(0), rejectedCount(0), nextPID(1), currentTime(0),
+      executionFile(executionFile),
+      memoryStatusFile(memoryStatusFile),
+      outputOpen(false),
+      usedMemory(0),
+      totalFreeMemory(0),
+      usableFreeMemory(0),
+      memoryStatusStarted(false),
+      binaryTrace(false),
+      loadedBytes(0),
+      loadSeconds(0),
+      dispatches(0),
       rng(std::random_device()()),
       execTimeDistr(1, 10),
-      schedulerType("FCFS")
+      schedulerType("FCFS"),
+      memoryWaitQueue(BuddyAllocator::ORDERS + 1),
+      memoryWaiting(0),
+      memoryFreed(false),
+      dynamicMemory(false),
+      compactionCost(0),
+      compactionUntil(0),
+      compactions(0),
+      compactionTime(0),
+      memoryCompacted(false),
+      settings{100, {50, 100, 200}, 1000, 20, 4},
+      eventDriven(false)
 {
+    setCoreCount(1);
     clearOutputFiles();
     initializeMemoryPartitions();
 }
 
 void OSSimulator::clearOutputFiles() {
-    std::ofstream("execution.txt", std::ios::trunc).close();
-    std::ofstream("memory_status.txt", std::ios::trunc).close();
+    bool executionOpen = executionTrace.open(executionFile);
+    bool memoryStatusOpen = memoryStatusTrace.open(memoryStatusFile);
+    outputOpen = executionOpen && memoryStatusOpen;
 }
 
 int OSSimulator::getRandomExecutionTime() {
@@ -91,339 +722,1025 @@ bool OSSimulator::isChildProcess(unsigned int pid) {
 
 void OSSimulator::initializeMemoryPartitions() {
     std::vector<unsigned int> sizes = {40, 25, 15, 10, 8, 2};
+    setPartitionSizes(sizes);
+}
+
+void OSSimulator::setPartitionSizes(const std::vector<unsigned int>& sizes) {
+    memoryPartitions.clear();
+    freePartitions.clear();
+    largestPartition = 0;
     for(unsigned int i = 0; i < sizes.size(); i++) {
-        memoryPartitions.push_back({i+1, sizes[i], -1});
+        memoryPartitions.push_back({i+1, sizes[i], -1, 0});
+        freePartitions.insert(std::make_pair(sizes[i], i));
+        largestPartition = std::max(largestPartition, sizes[i]);
+    }
+    // in dynamic memory mode the table is only used again once dynamic memory is switched off
+    if (!dynamicMemory) countPartitionMemory();
+}
+
+void OSSimulator::countPartitionMemory() {
+    usedMemory = 0;
+    totalFreeMemory = 0;
+    usableFreeMemory = 0;
+    for (const auto& partition : memoryPartitions) {
+        if (partition.occupiedBy >= 0) {
+            usedMemory += partition.size;
+            totalFreeMemory += partition.size - partition.used;
+        } else {
+            totalFreeMemory += partition.size;
+            usableFreeMemory += partition.size;
+        }
     }
 }
 
+bool OSSimulator::loadMemoryPartitions(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) return false;
+
+    std::vector<unsigned int> sizes;
+    std::string line;
+    while (std::getline(file, line)) {
+        for (const auto& part : utils::split_delim(line, ",")) {
+            std::string token = utils::trim(part);
+            if (token.empty()) continue;
+
+            // a partition needs a positive size and nothing but digits after it
+            size_t parsed = 0;
+            int size;
+            try {
+                size = std::stoi(token, &parsed);
+            } catch (const std::exception&) {
+                return false;
+            }
+            if (parsed != token.size() || size <= 0) return false;
+            sizes.push_back(size);
+        }
+    }
+    if (sizes.empty()) return false;
+
+    setPartitionSizes(sizes);
+    return true;
+}
+
 int OSSimulator::findBestFitPartition(unsigned int size) {
-    int bestFit = -1;
-    unsigned int minDiff = UINT_MAX;
-
-    for(size_t i = 0; i < memoryPartitions.size(); i++) {
-        if(memoryPartitions[i].occupiedBy == -1 && memoryPartitions[i].size >= size) {
-            unsigned int diff = memoryPartitions[i].size - size;
-            if(diff < minDiff) {
-                minDiff = diff;
-                bestFit = i;
+    auto it = freePartitions.lower_bound(std::make_pair(size, 0u));
+    if (it == freePartitions.end()) return -1;
+    return it->second;
+}
+
+void OSSimulator::allocatePartition(int partitionIndex, PCB* pcb) {
+    Partition& partition = memoryPartitions[partitionIndex];
+    freePartitions.erase(std::make_pair(partition.size, static_cast<unsigned int>(partitionIndex)));
+    partition.occupiedBy = pcb->pid;
+    partition.used = pcb->size;
+    pcb->partitionNumber = partition.number;
+    usedMemory += partition.size;
+    totalFreeMemory -= partition.used;
+    usableFreeMemory -= partition.size;
+}
+
+void OSSimulator::releasePartition(PCB* pcb) {
+    unsigned int partitionIndex = pcb->partitionNumber - 1;
+    Partition& partition = memoryPartitions[partitionIndex];
+    usedMemory -= partition.size;
+    totalFreeMemory += partition.used;
+    usableFreeMemory += partition.size;
+    partition.occupiedBy = -1;
+    partition.used = 0;
+    freePartitions.insert(std::make_pair(partition.size, partitionIndex));
+}
+
+bool OSSimulator::allocateMemory(PCB* pcb) {
+    if (!dynamicMemory) {
+        int partitionIndex = findBestFitPartition(pcb->size);
+        if (partitionIndex < 0) return false;
+        allocatePartition(partitionIndex, pcb);
+        return true;
+    }
+
+    unsigned int offset;
+    if (!buddyMemory.allocate(pcb, offset)) {
+        // compaction only helps if it leaves a free block big enough for the request
+        if (compactionCost <= 0 || memoryCompacted ||
+            buddyMemory.largestFreeAfterCompaction() < (1ULL << BuddyAllocator::orderFor(pcb->size))) {
+            return false;
+        }
+        compactMemory();
+        if (!buddyMemory.allocate(pcb, offset)) return false;
+    }
+    pcb->partitionNumber = offset;
+    countDynamicMemory();
+    return true;
+}
+
+void OSSimulator::releaseMemory(PCB* pcb) {
+    if (!dynamicMemory) {
+        releasePartition(pcb);
+        return;
+    }
+    buddyMemory.release(pcb->partitionNumber);
+    memoryCompacted = false;
+    countDynamicMemory();
+}
+
+void OSSimulator::countDynamicMemory() {
+    usedMemory = buddyMemory.allocatedSize();
+    totalFreeMemory = buddyMemory.totalSize() - buddyMemory.requestedSize();
+    usableFreeMemory = buddyMemory.totalSize() - buddyMemory.allocatedSize();
+}
+
+bool OSSimulator::canEverFit(unsigned int size) const {
+    if (!dynamicMemory) return size <= largestPartition;
+    unsigned int order = BuddyAllocator::orderFor(size);
+    return order < BuddyAllocator::ORDERS && (1u << order) <= buddyMemory.largestBlock();
+}
+
+unsigned int OSSimulator::largestAdmissible() const {
+    if (!dynamicMemory) {
+        return freePartitions.empty() ? 0 : freePartitions.rbegin()->first;
+    }
+    unsigned int largest = buddyMemory.largestFree();
+    if (compactionCost > 0 && !memoryCompacted) {
+        largest = std::max(largest, buddyMemory.largestFreeAfterCompaction());
+    }
+    return largest;
+}
+
+void OSSimulator::compactMemory() {
+    unsigned long moved = buddyMemory.compact();
+    memoryCompacted = true;
+    if (moved == 0) return;
+    memoryFreed = true;
+
+    unsigned int cost = static_cast<unsigned int>(std::ceil(moved * compactionCost));
+    compactions++;
+    compactionTime += cost;
+    compactionUntil = std::max(compactionUntil, currentTime) + cost;
+    scheduleEvent(compactionUntil);
+}
+
+void OSSimulator::setDynamicMemory(unsigned int totalSize) {
+    dynamicMemory = totalSize > 0;
+    buddyMemory.reset(totalSize);
+    if (dynamicMemory) {
+        countDynamicMemory();
+    } else {
+        countPartitionMemory();
+    }
+}
+
+void OSSimulator::setCompactionCost(double msPerUnit) {
+    compactionCost = msPerUnit;
+}
+
+void OSSimulator::setBinaryTrace(bool enabled) {
+    binaryTrace = enabled;
+}
+
+void OSSimulator::setTimeQuantum(unsigned int quantum) {
+    settings.timeQuantum = quantum;
+}
+
+void OSSimulator::setLevelQuanta(const std::vector<unsigned int>& quanta) {
+    if (quanta.empty()) return;
+    settings.levelQuanta.clear();
+    for (size_t i = 0; i < quanta.size() && i < ReadyQueue::MAX_LEVELS; i++) {
+        settings.levelQuanta.push_back(std::max(1u, quanta[i]));
+    }
+}
+
+void OSSimulator::setBoostInterval(unsigned int interval) {
+    settings.boostInterval = interval;
+}
+
+void OSSimulator::setTargetLatency(unsigned int latency) {
+    settings.targetLatency = std::max(1u, latency);
+}
+
+void OSSimulator::setMinGranularity(unsigned int granularity) {
+    settings.minGranularity = std::max(1u, granularity);
+}
+
+void OSSimulator::setCoreCount(unsigned int count) {
+    Core idle;
+    idle.runningProcess = nullptr;
+    idle.currentTimeSlice = 0;
+    idle.busyTime = 0;
+    idle.readyWeight = 0;
+    idle.minVruntime = 0;
+    cores.assign(std::max(1u, count), idle);
+}
+
+void OSSimulator::setEventDriven(bool enabled) {
+    eventDriven = enabled;
+}
+
+bool OSSimulator::parseProcessLine(const char* begin, const char* end, PCB& pcb, ProcessStats& stats) {
+    while (begin < end && std::strchr(" \t\n\r", *begin) != nullptr) begin++;
+    while (end > begin && std::strchr(" \t\n\r", end[-1]) != nullptr) end--;
+    if (begin == end) return false;
+
+    // split on commas and drop empty fields, the same way as utils::split_delim
+    const char* fieldBegin[7];
+    const char* fieldEnd[7];
+    size_t fields = 0;
+    const char* field = begin;
+    for (const char* p = begin; ; p++) {
+        if (p == end || *p == ',') {
+            if (p > field) {
+                if (fields < 7) {
+                    fieldBegin[fields] = field;
+                    fieldEnd[fields] = p;
+                }
+                fields++;
             }
+            if (p == end) break;
+            field = p + 1;
+        }
+    }
+    if (fields < 6) return false;
+
+    pcb.pid = utils::parseInt(fieldBegin[0], fieldEnd[0]);
+    pcb.size = utils::parseInt(fieldBegin[1], fieldEnd[1]);
+    pcb.arrivalTime = utils::parseInt(fieldBegin[2], fieldEnd[2]);
+    stats.totalCPUTime = utils::parseInt(fieldBegin[3], fieldEnd[3]);
+    pcb.remainingCPUTime = stats.totalCPUTime;
+    pcb.ioFrequency = utils::parseInt(fieldBegin[4], fieldEnd[4]);
+    pcb.ioDuration = utils::parseInt(fieldBegin[5], fieldEnd[5]);
+    pcb.nextIOTime = pcb.ioFrequency;
+    pcb.state = NEW;
+    pcb.partitionNumber = 0;
+    pcb.wakeTime = 0;
+    pcb.timerOrder = 0;
+    pcb.core = 0;
+    pcb.level = 0;
+    pcb.vruntime = 0;
+    pcb.prevInQueue = nullptr;
+    pcb.nextInQueue = nullptr;
+
+    char name[32];
+    int nameLength = std::snprintf(name, sizeof(name), "Program_%u", pcb.pid);
+    stats.programName.assign(name, nameLength);
+
+    stats.startTime = 0;
+    stats.finishTime = 0;
+    stats.responseTime = 0;
+    stats.hasStarted = false;
+    stats.lastScheduledTime = 0;
+    stats.readySince = 0;
+    stats.totalWaitTime = 0;
+    stats.ioStartTime = 0;
+    stats.totalIOTime = 0;
+    stats.numberOfIO = 0;
+
+    if (fields >= 7) {
+        pcb.priority = utils::parseInt(fieldBegin[6], fieldEnd[6]);
+    } else {
+        pcb.priority = 0;
+    }
+    return true;
+}
+
+void OSSimulator::parseProcessChunk(const char* begin, const char* end, std::vector<PCB>& pcbs, std::vector<ProcessStats>& stats) {
+    size_t lines = std::count(begin, end, '\n') + 1;
+    pcbs.reserve(pcbs.size() + lines);
+    stats.reserve(stats.size() + lines);
+
+    PCB pcb;
+    ProcessStats processStats;
+    for (const char* line = begin; line < end;) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (lineEnd == nullptr) lineEnd = end;
+        if (parseProcessLine(line, lineEnd, pcb, processStats)) {
+            pcbs.push_back(pcb);
+            stats.push_back(processStats);
         }
+        line = lineEnd + 1;
     }
-    return bestFit;
 }
 
 void OSSimulator::loadProcesses(const std::string& filename) {
-    std::ifstream file(filename);
-    std::string line;
-    while(std::getline(file, line)) {
-        line = utils::trim(line);
-        if(line.empty()) continue;
-
-        auto parts = utils::split_delim(line, ",");
-        if(parts.size() < 6) continue;
-
-        PCB pcb;
-        pcb.pid = std::stoi(utils::trim(parts[0]));
-        pcb.size = std::stoi(utils::trim(parts[1]));
-        pcb.arrivalTime = std::stoi(utils::trim(parts[2]));
-        pcb.totalCPUTime = std::stoi(utils::trim(parts[3]));
-        pcb.remainingCPUTime = pcb.totalCPUTime;
-        pcb.ioFrequency = std::stoi(utils::trim(parts[4]));
-        pcb.initialIOFrequency = pcb.ioFrequency;
-        pcb.ioDuration = std::stoi(utils::trim(parts[5]));
-        pcb.initialIODuration = pcb.ioDuration;
-        pcb.nextIOTime = pcb.ioFrequency;
-        pcb.state = NEW;
-        pcb.partitionNumber = 0;
-        pcb.programName = "Program_" + std::to_string(pcb.pid);
-        pcb.lastScheduledTime = 0;
-        pcb.totalWaitTime = 0;
-        pcb.startTime = 0;
-        pcb.finishTime = 0;
-        pcb.responseTime = 0;
-        pcb.hasStarted = false;
-        pcb.totalIOTime = 0;
-        pcb.numberOfIO = 0;
-
-        if(parts.size() >= 7) {
-            pcb.priority = std::stoi(utils::trim(parts[6]));
-        } else {
-            pcb.priority = 0;
+    const size_t minChunkBytes = 1 << 20;
+    auto start = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (!file.open(filename) || file.size() == 0) return;
+
+    const char* data = file.data();
+    const char* end = data + file.size();
+
+    // split the file into one chunk per core, each chunk ending just after a newline
+    size_t chunks = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), file.size() / minChunkBytes + 1);
+    std::vector<const char*> bounds(1, data);
+    for (size_t i = 1; i < chunks; i++) {
+        const char* bound = std::max(bounds.back(), data + file.size() * i / chunks);
+        const char* newline = static_cast<const char*>(std::memchr(bound, '\n', end - bound));
+        bounds.push_back(newline != nullptr ? newline + 1 : end);
+    }
+    bounds.push_back(end);
+
+    std::vector<std::vector<PCB> > parsed(chunks);
+    std::vector<std::vector<ProcessStats> > parsedStats(chunks);
+    std::vector<std::exception_ptr> errors(chunks);
+    auto parseChunk = [&](size_t i) {
+        try {
+            parseProcessChunk(bounds[i], bounds[i + 1], parsed[i], parsedStats[i]);
+        } catch (...) {
+            errors[i] = std::current_exception();
         }
+    };
 
-        pcbTable.push_back(pcb);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunks; i++) {
+        workers.push_back(std::thread(parseChunk, i));
     }
+    parseChunk(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // report the first bad line in file order, as the sequential parser would
+    for (auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    size_t total = pcbTable.size();
+    for (const auto& chunk : parsed) total += chunk.size();
+    pcbTable.reserve(total);
+    processStats.reserve(total);
+    for (size_t i = 0; i < chunks; i++) {
+        pcbTable.insert(pcbTable.end(), parsed[i].begin(), parsed[i].end());
+        std::move(parsedStats[i].begin(), parsedStats[i].end(), std::back_inserter(processStats));
+    }
+
+    // the simulation admits processes through a cursor over this order instead of scanning the table every tick
+    arrivalOrder.resize(pcbTable.size());
+    for (size_t i = 0; i < arrivalOrder.size(); i++) arrivalOrder[i] = i;
+    std::stable_sort(arrivalOrder.begin(), arrivalOrder.end(),
+                     [this](unsigned int a, unsigned int b) { return pcbTable[a].arrivalTime < pcbTable[b].arrivalTime; });
+
+    loadedBytes += file.size();
+    loadSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void OSSimulator::printLoadStats() const {
+    double megabytes = loadedBytes / 1e6;
+    std::cout << "Loaded " << pcbTable.size() << " processes (" << megabytes << " MB";
+    if (loadSeconds > 0) {
+        std::cout << ", " << megabytes / loadSeconds << " MB/s";
+    }
+    std::cout << ")\n";
+}
+
+const OSSimulator::SchedulerEntry OSSimulator::schedulers[] = {
+    {"FCFS", &OSSimulator::runSimulation<FCFSPolicy>},
+    {"EP", &OSSimulator::runSimulation<EPPolicy>},
+    {"RR", &OSSimulator::runSimulation<RRPolicy>},
+    {"SJF", &OSSimulator::runSimulation<SJFPolicy>},
+    {"SRTF", &OSSimulator::runSimulation<SRTFPolicy>},
+    {"MLFQ", &OSSimulator::runSimulation<MLFQPolicy>},
+    {"CFS", &OSSimulator::runSimulation<CFSPolicy>},
+};
+
+bool OSSimulator::outputFilesOpen() const {
+    return outputOpen;
+}
+
+size_t OSSimulator::processCount() const {
+    return pcbTable.size();
+}
+
+bool OSSimulator::hasScheduler(const std::string& schedulerType) {
+    for (const auto& scheduler : schedulers) {
+        if (schedulerType == scheduler.name) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void OSSimulator::simulate(const std::string& schedulerType) {
     this->schedulerType = schedulerType;
-    std::vector<PCB*> readyQueue;
-    std::vector<PCB*> waitingQueue;
-    std::vector<PCB*> memoryWaitQueue;
-    PCB* runningProcess = nullptr;
-    const unsigned int timeQuantum = 100;
-    unsigned int currentTimeSlice = 0;
+    for (const auto& scheduler : schedulers) {
+        if (schedulerType == scheduler.name) {
+            (this->*scheduler.run)();
+            return;
+        }
+    }
+    std::cerr << "Unknown scheduler " << schedulerType << "\n";
+}
 
-    executionLog += "+--------------------+-----+-------------+------------+\n";
-    executionLog += "| Time of Transition | PID |  Old State  | New State  |\n";
-    executionLog += "+--------------------+-----+-------------+------------+\n";
+template <typename Policy>
+void OSSimulator::runSimulation() {
+    for (auto& core : cores) {
+        core.readyQueue.setKeyed(Policy::keyed);
+        core.readyQueue.setLevels(Policy::levels(settings));
+    }
 
-    while (true) {
-        bool allTerminated = true;
-        for (auto& pcb : pcbTable) {
-            if (pcb.state != TERMINATED) {
-                allTerminated = false;
-                break;
-            }
+    if (binaryTrace) {
+        openBinaryTraces();
+    } else {
+        tables::writeExecutionHeader(executionTrace);
+    }
+
+    while (!allProcessesTerminated()) {
+        runTick<Policy>();
+
+        if (allProcessesTerminated()) {
+            currentTime++;
+            break;
         }
-        if (allTerminated) break;
-
-        for (auto& pcb : pcbTable) {
-            if (pcb.arrivalTime == currentTime && pcb.state == NEW) {
-                int partitionIndex = findBestFitPartition(pcb.size);
-                if (partitionIndex >= 0) {
-                    memoryPartitions[partitionIndex].occupiedBy = pcb.pid;
-                    pcb.partitionNumber = memoryPartitions[partitionIndex].number;
-                    pcb.state = READY;
-                    pcb.startTime = currentTime;
-                    saveMemoryStatus(currentTime);
-                    logStateTransition(currentTime, pcb.pid, "NEW", "READY");
-                    readyQueue.push_back(&pcb);
-                } else {
-                    memoryWaitQueue.push_back(&pcb);
-                }
-            }
+
+        // both engines stop the same way once nothing can change any more
+        unsigned int next = currentTime + 1;
+        if (!canProgress() || (eventDriven && !nextEventTime(next))) {
+            currentTime++;
+            std::cerr << "Simulation stalled at " << currentTime << " ms: no pending events\n";
+            break;
+        }
+        if (eventDriven) {
+            skipIdleTicks<Policy>(next - currentTime - 1);
         }
+        currentTime = next;
+    }
+}
 
-        for (auto it = memoryWaitQueue.begin(); it != memoryWaitQueue.end();) {
-            PCB* pcb = *it;
-            int partitionIndex = findBestFitPartition(pcb->size);
-            if (partitionIndex >= 0) {
-                memoryPartitions[partitionIndex].occupiedBy = pcb->pid;
-                pcb->partitionNumber = memoryPartitions[partitionIndex].number;
-                pcb->state = READY;
-                pcb->startTime = currentTime;
-                saveMemoryStatus(currentTime);
-                logStateTransition(currentTime, pcb->pid, "NEW", "READY");
-                readyQueue.push_back(pcb);
-                it = memoryWaitQueue.erase(it);
-            } else {
-                ++it;
-            }
+bool OSSimulator::allProcessesTerminated() const {
+    return terminatedCount + rejectedCount == pcbTable.size();
+}
+
+bool OSSimulator::canProgress() const {
+    if (nextArrival < arrivalOrder.size() || !waitingQueue.empty() || currentTime + 1 < compactionUntil) return true;
+    if (memoryFreed && memoryWaiting > 0) return true;
+    for (const auto& core : cores) {
+        if (core.runningProcess != nullptr || !core.readyQueue.empty()) return true;
+    }
+    return false;
+}
+
+unsigned int OSSimulator::leastLoadedCore() const {
+    unsigned int best = 0;
+    size_t bestLoad = SIZE_MAX;
+    for (unsigned int i = 0; i < cores.size(); i++) {
+        size_t load = cores[i].readyQueue.size() + (cores[i].runningProcess != nullptr ? 1 : 0);
+        if (load < bestLoad) {
+            bestLoad = load;
+            best = i;
         }
+    }
+    return best;
+}
 
-        for (auto it = waitingQueue.begin(); it != waitingQueue.end();) {
-            PCB* pcb = *it;
-            pcb->ioDuration--;
-            pcb->totalIOTime++;
+template <typename Policy>
+void OSSimulator::makeReady(PCB* pcb, unsigned int core) {
+    pcb->core = core;
+    statsOf(pcb).readySince = currentTime;
+    Core& target = cores[core];
+    Policy::onReady(target, *pcb);
+    target.readyQueue.push(pcb, Policy::readyKey(*pcb));
+}
 
-            if (pcb->ioDuration <= 0) {
-                pcb->state = READY;
-                pcb->ioDuration = pcb->initialIODuration;
-                pcb->nextIOTime = pcb->initialIOFrequency;
-                logStateTransition(currentTime, pcb->pid, "WAITING", "READY");
-                readyQueue.push_back(pcb);
-                it = waitingQueue.erase(it);
-            } else {
-                ++it;
-            }
+template <typename Policy>
+PCB* OSSimulator::takeReady(Core& core) {
+    PCB* pcb = core.readyQueue.pop();
+    if (pcb != nullptr) Policy::onDequeue(core, *pcb);
+    return pcb;
+}
+
+ProcessStats& OSSimulator::statsOf(const PCB* pcb) {
+    return processStats[pcb - pcbTable.data()];
+}
+
+template <typename Policy>
+PCB* OSSimulator::stealWork(unsigned int thief) {
+    // only queued work that its own core cannot start this tick is worth stealing
+    int victim = -1;
+    size_t mostSurplus = 0;
+    for (unsigned int i = 0; i < cores.size(); i++) {
+        if (i == thief) continue;
+        size_t queued = cores[i].readyQueue.size();
+        size_t surplus = cores[i].runningProcess != nullptr ? queued : (queued > 0 ? queued - 1 : 0);
+        if (surplus > mostSurplus) {
+            mostSurplus = surplus;
+            victim = i;
         }
+    }
+    if (victim < 0) return nullptr;
 
-        if (schedulerType == "RR" && runningProcess != nullptr) {
-            if (currentTimeSlice >= timeQuantum) {
-                runningProcess->state = READY;
-                logStateTransition(currentTime, runningProcess->pid, "RUNNING", "READY");
-                readyQueue.push_back(runningProcess);
-                runningProcess = nullptr;
-                currentTimeSlice = 0;
-            }
+    PCB* pcb = takeReady<Policy>(cores[victim]);
+    pcb->core = thief;
+    return pcb;
+}
+
+template <typename Policy>
+void OSSimulator::admit(PCB* pcb) {
+    pcb->state = READY;
+    statsOf(pcb).startTime = currentTime;
+    saveMemoryStatus(currentTime);
+    logStateTransition(currentTime, pcb->pid, NEW, READY);
+    makeReady<Policy>(pcb, leastLoadedCore());
+}
+
+template <typename Policy>
+void OSSimulator::admitWaiting() {
+    // class c only holds sizes above 2^(c-1), so it is skipped once the largest admissible size is not above that
+    unsigned int largest = largestAdmissible();
+    auto fits = [&largest](unsigned int sizeClass) { return largest > 0 && (sizeClass == 0 || largest > 1u << (sizeClass - 1)); };
+
+    std::vector<PCB*> cursors(memoryWaitQueue.size(), nullptr);
+    for (unsigned int c = 0; c < memoryWaitQueue.size(); c++) {
+        if (fits(c)) cursors[c] = memoryWaitQueue[c].front();
+    }
+
+    // merging the classes by arrival keeps the order in which a single queue would retry them
+    auto arrivesBefore = [this](const PCB* a, const PCB* b) {
+        return a->arrivalTime != b->arrivalTime ? a->arrivalTime < b->arrivalTime : a < b;
+    };
+    while (true) {
+        unsigned int next = memoryWaitQueue.size();
+        for (unsigned int c = 0; c < cursors.size(); c++) {
+            if (cursors[c] != nullptr && (next == cursors.size() || arrivesBefore(cursors[c], cursors[next]))) next = c;
         }
+        if (next == cursors.size()) break;
 
-        if (runningProcess == nullptr && !readyQueue.empty()) {
-            PCB* nextProcess = nullptr;
+        PCB* pcb = cursors[next];
+        cursors[next] = pcb->nextInQueue;
+        if (!allocateMemory(pcb)) continue;
 
-            if (schedulerType == "FCFS") {
-                nextProcess = readyQueue.front();
-                readyQueue.erase(readyQueue.begin());
-            } 
-            else if (schedulerType == "EP") {
-                auto highestPriority = std::min_element(readyQueue.begin(), readyQueue.end(),
-                    [](PCB* a, PCB* b) { return a->priority < b->priority; });
-                nextProcess = *highestPriority;
-                readyQueue.erase(highestPriority);
-            }
-            else if (schedulerType == "RR") {
-                nextProcess = readyQueue.front();
-                readyQueue.erase(readyQueue.begin());
-                currentTimeSlice = 0;
-            }
+        memoryWaitQueue[next].remove(pcb);
+        memoryWaiting--;
+        admit<Policy>(pcb);
+        largest = largestAdmissible();
+        for (unsigned int c = 0; c < cursors.size(); c++) {
+            if (!fits(c)) cursors[c] = nullptr;
+        }
+    }
+}
 
-            if (nextProcess != nullptr) {
-                runningProcess = nextProcess;
-                runningProcess->state = RUNNING;
-                if (!runningProcess->hasStarted) {
-                    runningProcess->responseTime = currentTime - runningProcess->arrivalTime;
-                    runningProcess->hasStarted = true;
-                }
-                runningProcess->lastScheduledTime = currentTime;
-                logStateTransition(currentTime, runningProcess->pid, "READY", "RUNNING");
-            }
+bool OSSimulator::idleCoreCanDispatch() const {
+    bool idleCore = false;
+    bool queuedWork = false;
+    for (const auto& core : cores) {
+        if (core.runningProcess == nullptr) idleCore = true;
+        if (!core.readyQueue.empty()) queuedWork = true;
+    }
+    return idleCore && queuedWork;
+}
+
+template <typename Policy>
+void OSSimulator::runTick() {
+    for (; nextArrival < arrivalOrder.size() && pcbTable[arrivalOrder[nextArrival]].arrivalTime <= currentTime; nextArrival++) {
+        PCB& pcb = pcbTable[arrivalOrder[nextArrival]];
+        if (allocateMemory(&pcb)) {
+            admit<Policy>(&pcb);
+        } else if (!canEverFit(pcb.size)) {
+            rejectedCount++;
+            std::cerr << "Process " << pcb.pid << " needs " << pcb.size << " units of memory and can never fit, it is not admitted\n";
+        } else {
+            memoryWaitQueue[sizeClass(pcb.size)].pushBack(&pcb);
+            memoryWaiting++;
         }
+    }
+
+    // free blocks only grow when a process terminates or memory is compacted, waiting processes are retried once after that
+    if (memoryFreed) {
+        memoryFreed = false;
+        if (memoryWaiting > 0) admitWaiting<Policy>();
+    }
+
+    waitingQueue.advance(currentTime, ioCompletions);
+    for (PCB* pcb : ioCompletions) {
+        pcb->state = READY;
+        ProcessStats& stats = statsOf(pcb);
+        stats.totalIOTime += currentTime - stats.ioStartTime;
+        pcb->nextIOTime = pcb->ioFrequency;
+        Policy::onIOComplete(*pcb);
+        logStateTransition(currentTime, pcb->pid, WAITING, READY);
+        makeReady<Policy>(pcb, pcb->core);
+    }
 
-        if (runningProcess != nullptr) {
-            runningProcess->remainingCPUTime--;
-            runningProcess->nextIOTime--;
-            if (schedulerType == "RR") {
-                currentTimeSlice++;
+    unsigned int period = Policy::period(settings);
+    if (period > 0 && currentTime > 0 && currentTime % period == 0) {
+        Policy::onPeriod(cores, waitingQueue);
+    }
+
+    for (unsigned int i = 0; i < cores.size(); i++) {
+        Core& core = cores[i];
+        if (core.runningProcess != nullptr) {
+            bool quantumExpired = core.currentTimeSlice >= Policy::quantum(core, settings);
+            if (quantumExpired || Policy::preempts(core)) {
+                if (quantumExpired) Policy::onQuantumExpired(*core.runningProcess, settings);
+                core.runningProcess->state = READY;
+                logStateTransition(currentTime, core.runningProcess->pid, RUNNING, READY);
+                makeReady<Policy>(core.runningProcess, i);
+                core.runningProcess = nullptr;
+                core.currentTimeSlice = 0;
             }
+        }
+    }
 
-            if (runningProcess->remainingCPUTime <= 0) {
-                runningProcess->state = TERMINATED;
-                runningProcess->finishTime = currentTime;
-                for (auto& partition : memoryPartitions) {
-                    if (partition.occupiedBy == runningProcess->pid) {
-                        partition.occupiedBy = -1;
-                        break;
-                    }
-                }
-                saveMemoryStatus(currentTime);
-                logStateTransition(currentTime, runningProcess->pid, "RUNNING", "TERMINATED");
-                runningProcess = nullptr;
-                currentTimeSlice = 0;
-            } else if (runningProcess->nextIOTime <= 0) {
-                runningProcess->state = WAITING;
-                runningProcess->nextIOTime = runningProcess->initialIOFrequency;
-                runningProcess->ioDuration = runningProcess->initialIODuration;
-                runningProcess->numberOfIO++;
-                logStateTransition(currentTime, runningProcess->pid, "RUNNING", "WAITING");
-                waitingQueue.push_back(runningProcess);
-                runningProcess = nullptr;
-                currentTimeSlice = 0;
+    for (unsigned int i = 0; i < cores.size(); i++) {
+        Core& core = cores[i];
+        if (core.runningProcess != nullptr) continue;
+
+        PCB* nextProcess = core.readyQueue.empty() ? stealWork<Policy>(i) : takeReady<Policy>(core);
+        core.currentTimeSlice = 0;
+
+        if (nextProcess != nullptr) {
+            dispatches++;
+            ProcessStats& stats = statsOf(nextProcess);
+            stats.totalWaitTime += currentTime - stats.readySince;
+            if (!stats.hasStarted) {
+                stats.responseTime = currentTime - nextProcess->arrivalTime;
+                stats.hasStarted = true;
             }
+            stats.lastScheduledTime = currentTime;
+            core.runningProcess = nextProcess;
+            core.runningProcess->state = RUNNING;
+            logStateTransition(currentTime, core.runningProcess->pid, READY, RUNNING);
         }
+    }
+
+    // compaction stalls every cpu until it is done
+    bool stalled = currentTime < compactionUntil;
+    for (auto& core : cores) {
+        PCB*& runningProcess = core.runningProcess;
+        if (runningProcess == nullptr || stalled) continue;
 
-        for (auto& pcb : readyQueue) {
-            pcb->totalWaitTime++;
+        core.busyTime++;
+        runningProcess->remainingCPUTime--;
+        runningProcess->nextIOTime--;
+        core.currentTimeSlice++;
+        Policy::onRun(*runningProcess, 1);
+
+        if (runningProcess->remainingCPUTime <= 0) {
+            runningProcess->state = TERMINATED;
+            terminatedCount++;
+            ProcessStats& stats = statsOf(runningProcess);
+            stats.finishTime = currentTime;
+            latency.turnaround.record(currentTime - runningProcess->arrivalTime);
+            latency.wait.record(stats.totalWaitTime);
+            latency.response.record(stats.responseTime);
+            latency.io.record(stats.totalIOTime);
+            releaseMemory(runningProcess);
+            memoryFreed = true;
+            saveMemoryStatus(currentTime);
+            logStateTransition(currentTime, runningProcess->pid, RUNNING, TERMINATED);
+            runningProcess = nullptr;
+            core.currentTimeSlice = 0;
+        } else if (runningProcess->nextIOTime <= 0) {
+            runningProcess->state = WAITING;
+            runningProcess->nextIOTime = runningProcess->ioFrequency;
+            statsOf(runningProcess).numberOfIO++;
+            logStateTransition(currentTime, runningProcess->pid, RUNNING, WAITING);
+            statsOf(runningProcess).ioStartTime = currentTime;
+            waitingQueue.schedule(runningProcess, currentTime + std::max(1u, runningProcess->ioDuration));
+            scheduleEvent(runningProcess->wakeTime);
+            runningProcess = nullptr;
+            core.currentTimeSlice = 0;
+        }
+    }
+
+    // the next tick is busy if a cpu is free with work queued or freed memory can admit a process
+    if (idleCoreCanDispatch() || (memoryFreed && memoryWaiting > 0)) {
+        scheduleEvent(currentTime + 1);
+    }
+    for (const auto& core : cores) {
+        if (core.runningProcess == nullptr) continue;
+        scheduleEvent(currentTime + std::min(core.runningProcess->remainingCPUTime, core.runningProcess->nextIOTime));
+        unsigned int quantum = Policy::quantum(core, settings);
+        if (quantum != Policy::NO_QUANTUM) {
+            scheduleEvent(currentTime + (core.currentTimeSlice < quantum ? quantum - core.currentTimeSlice + 1 : 1));
         }
+    }
+    if (period > 0) {
+        scheduleEvent((currentTime / period + 1) * period);
+    }
+}
+
+void OSSimulator::scheduleEvent(unsigned int time) {
+    if (eventDriven && time > currentTime) {
+        pendingEvents.push(time);
+    }
+}
 
-        currentTime++;
+bool OSSimulator::nextEventTime(unsigned int& time) {
+    while (!pendingEvents.empty() && pendingEvents.top() <= currentTime) {
+        pendingEvents.pop();
+    }
+    // arrivals are not queued as events, the next one is always at the arrival cursor
+    bool arrivalPending = nextArrival < arrivalOrder.size();
+    if (pendingEvents.empty() && !arrivalPending) {
+        return false;
+    }
+    time = UINT_MAX;
+    if (arrivalPending) {
+        time = pcbTable[arrivalOrder[nextArrival]].arrivalTime;
+    }
+    if (!pendingEvents.empty() && pendingEvents.top() <= time) {
+        time = pendingEvents.top();
+        pendingEvents.pop();
+    }
+    return true;
+}
+
+template <typename Policy>
+void OSSimulator::skipIdleTicks(unsigned int ticks) {
+    // the end of a compaction is an event, so skipped ticks are either all stalled or none are
+    if (ticks == 0 || currentTime + 1 < compactionUntil) return;
+
+    for (auto& core : cores) {
+        if (core.runningProcess != nullptr) {
+            core.busyTime += ticks;
+            core.runningProcess->remainingCPUTime -= ticks;
+            core.runningProcess->nextIOTime -= ticks;
+            core.currentTimeSlice += ticks;
+            Policy::onRun(*core.runningProcess, ticks);
+        }
     }
 }
 
-void OSSimulator::logStateTransition(unsigned int time, unsigned int pid, const std::string& oldState, const std::string& newState) {
-    std::stringstream ss;
-    ss << "| " << std::setw(18) << std::left << time << " | "
-       << std::setw(3) << std::left << pid << " | "
-       << std::setw(11) << std::left << oldState << " | "
-       << std::setw(10) << std::left << newState << " |\n";
-    executionLog += ss.str();
+void OSSimulator::logStateTransition(unsigned int time, unsigned int pid, ProcessState oldState, ProcessState newState) {
+    if (binaryTrace) {
+        TransitionRecord record = {time, pid, static_cast<uint8_t>(oldState), static_cast<uint8_t>(newState), {0, 0}};
+        executionTrace.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    } else {
+        tables::writeExecutionRow(executionTrace, time, pid, oldState, newState);
+    }
 }
 
 void OSSimulator::saveMemoryStatus(unsigned int time) {
-    std::stringstream ss;
-    unsigned int memoryUsed = 0;
-    unsigned int totalFreeMemory = 0;
-    unsigned int usableFreeMemory = 0;
-    std::vector<int> partitionsState;
-    for (auto& partition : memoryPartitions) {
-        if (partition.occupiedBy != -1) {
-            memoryUsed += partition.size;
-            partitionsState.push_back(partition.occupiedBy);
+    if (!binaryTrace) {
+        if (!memoryStatusStarted) {
+            tables::writeMemoryStatusHeader(memoryStatusTrace);
+            memoryStatusStarted = true;
+        }
+        // the totals are kept up to date on allocate and release, the layout column is written straight from memory
+        tables::writeMemoryStatusStart(memoryStatusTrace, time, usedMemory);
+        size_t partitionsLength = 0;
+        if (dynamicMemory) {
+            buddyMemory.forEachBlock([this, &partitionsLength](unsigned int, unsigned int, const PCB* owner) {
+                int pid = owner != nullptr ? static_cast<int>(owner->pid) : -1;
+                partitionsLength += tables::writeMemoryStatusCell(memoryStatusTrace, pid, partitionsLength == 0);
+            });
         } else {
-            totalFreeMemory += partition.size;
-            usableFreeMemory += partition.size;
-            partitionsState.push_back(-1);
+            for (const auto& partition : memoryPartitions) {
+                partitionsLength += tables::writeMemoryStatusCell(memoryStatusTrace, partition.occupiedBy, partitionsLength == 0);
+            }
         }
+        tables::writeMemoryStatusEnd(memoryStatusTrace, partitionsLength, totalFreeMemory, usableFreeMemory);
+        return;
     }
 
-    if (memoryStatusLog.empty()) {
-        memoryStatusLog += "+------------+------------+---------------------------+-------------------+-------------------+\n";
-        memoryStatusLog += "| Time Event | Memory Used|   Partitions State        | Total Free Memory | Usable Free Memory|\n";
-        memoryStatusLog += "+------------+------------+---------------------------+-------------------+-------------------+\n";
+    MemoryStatusRecord record = {time, usedMemory, totalFreeMemory, usableFreeMemory};
+    memoryStatusTrace.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    if (dynamicMemory) {
+        uint32_t blockCount = buddyMemory.blockCount();
+        memoryStatusTrace.write(reinterpret_cast<const char*>(&blockCount), sizeof(blockCount));
+        buddyMemory.forEachBlock([this](unsigned int, unsigned int, const PCB* owner) {
+            int32_t pid = owner != nullptr ? static_cast<int32_t>(owner->pid) : -1;
+            memoryStatusTrace.write(reinterpret_cast<const char*>(&pid), sizeof(pid));
+        });
+        return;
     }
+    for (const auto& partition : memoryPartitions) {
+        int32_t pid = partition.occupiedBy;
+        memoryStatusTrace.write(reinterpret_cast<const char*>(&pid), sizeof(pid));
+    }
+}
 
-    ss << "| " << std::setw(10) << std::left << time << " | "
-       << std::setw(10) << std::left << memoryUsed << " | ";
+void OSSimulator::openBinaryTraces() {
+    auto binaryName = [](const std::string& filename) {
+        size_t dot = filename.find_last_of('.');
+        size_t slash = filename.find_last_of('/');
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return filename + ".bin";
+        return filename.substr(0, dot) + ".bin";
+    };
 
-    std::stringstream ps;
-    for (size_t i = 0; i < partitionsState.size(); i++) {
-        ps << partitionsState[i];
-        if (i != partitionsState.size() -1) ps << ", ";
-    }
-    ss << std::setw(25) << std::left << ps.str() << " | "
-       << std::setw(17) << std::left << totalFreeMemory << " | "
-       << std::setw(17) << std::left << usableFreeMemory << " |\n";
+    bool executionOpen = executionTrace.open(binaryName(executionFile));
+    TraceFileHeader executionHeader;
+    std::memcpy(executionHeader.magic, EXECUTION_TRACE_MAGIC, sizeof(executionHeader.magic));
+    executionHeader.recordSize = sizeof(TransitionRecord);
+    executionHeader.partitionCount = 0;
+    executionTrace.write(reinterpret_cast<const char*>(&executionHeader), sizeof(executionHeader));
 
-    memoryStatusLog += ss.str();
+    bool memoryStatusOpen = memoryStatusTrace.open(binaryName(memoryStatusFile));
+    outputOpen = executionOpen && memoryStatusOpen;
+    TraceFileHeader memoryHeader;
+    std::memcpy(memoryHeader.magic, dynamicMemory ? BLOCK_MEMORY_TRACE_MAGIC : MEMORY_TRACE_MAGIC, sizeof(memoryHeader.magic));
+    // dynamic memory has no fixed partitions, every record says how many blocks follow it
+    size_t partitionCount = dynamicMemory ? 0 : memoryPartitions.size();
+    memoryHeader.recordSize = sizeof(MemoryStatusRecord) + partitionCount * sizeof(int32_t);
+    memoryHeader.partitionCount = partitionCount;
+    memoryStatusTrace.write(reinterpret_cast<const char*>(&memoryHeader), sizeof(memoryHeader));
+    for (size_t i = 0; i < partitionCount; i++) {
+        const Partition& partition = memoryPartitions[i];
+        uint32_t size = partition.size;
+        memoryStatusTrace.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    }
 }
 
 void OSSimulator::saveExecution() {
-    executionLog += "+--------------------+-----+-------------+------------+\n";
-    std::ofstream file("execution.txt");
-    file << executionLog;
+    if (!binaryTrace) {
+        tables::writeExecutionFooter(executionTrace);
+    }
+    executionTrace.flush();
 }
 
 void OSSimulator::saveMemoryStatus() {
-    memoryStatusLog += "+------------+------------+---------------------------+-------------------+-------------------+\n";
-    std::ofstream file("memory_status.txt");
-    file << memoryStatusLog;
+    if (!binaryTrace) {
+        tables::writeMemoryStatusFooter(memoryStatusTrace);
+    }
+    memoryStatusTrace.flush();
 }
 
-void OSSimulator::calculateMetrics() {
-    unsigned int totalTurnaroundTime = 0;
-    unsigned int totalWaitTime = 0;
-    unsigned int totalResponseTime = 0;
-    unsigned int totalProcesses = pcbTable.size();
+constexpr unsigned int LatencyHistogram::SUB_BUCKET_BITS;
+constexpr unsigned int LatencyHistogram::SUB_BUCKETS;
+constexpr unsigned int LatencyHistogram::BUCKETS;
+
+LatencyHistogram::LatencyHistogram() : buckets(BUCKETS, 0), total(0), maximum(0) {}
+
+unsigned int LatencyHistogram::bucketOf(unsigned int value) {
+    if (value < SUB_BUCKETS) return value;
+    // the top SUB_BUCKET_BITS bits of the value pick the sub-bucket, every power of two above adds half a row
+    unsigned int shift = (31 - __builtin_clz(value)) - SUB_BUCKET_BITS + 1;
+    return shift * (SUB_BUCKETS / 2) + (value >> shift);
+}
+
+unsigned int LatencyHistogram::highestInBucket(unsigned int bucket) {
+    if (bucket < SUB_BUCKETS) return bucket;
+    unsigned int shift = bucket / (SUB_BUCKETS / 2) - 1;
+    unsigned int lowest = (bucket - shift * (SUB_BUCKETS / 2)) << shift;
+    return lowest + ((1u << shift) - 1);
+}
+
+void LatencyHistogram::record(unsigned int value) {
+    buckets[bucketOf(value)]++;
+    total++;
+    maximum = std::max(maximum, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (unsigned int i = 0; i < BUCKETS; i++) buckets[i] += other.buckets[i];
+    total += other.total;
+    maximum = std::max(maximum, other.maximum);
+}
+
+unsigned int LatencyHistogram::percentile(double percent) const {
+    if (total == 0) return 0;
+    unsigned long long rank = static_cast<unsigned long long>(percent / 100 * total + 0.5);
+    rank = std::min(std::max(rank, 1ULL), total);
+
+    unsigned long long seen = 0;
+    for (unsigned int i = 0; i < BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) return std::min(highestInBucket(i), maximum);
+    }
+    return maximum;
+}
+
+void LatencyHistograms::merge(const LatencyHistograms& other) {
+    turnaround.merge(other.turnaround);
+    wait.merge(other.wait);
+    response.merge(other.response);
+    io.merge(other.io);
+}
+
+SimulationMetrics OSSimulator::computeMetrics() const {
+    unsigned long long totalTurnaroundTime = 0;
+    unsigned long long totalWaitTime = 0;
+    unsigned long long totalResponseTime = 0;
     unsigned int processesCompleted = 0;
-    unsigned int totalIOTime = 0;
+    unsigned long long totalIOTime = 0;
 
-    for (const auto& pcb : pcbTable) {
-        if (pcb.state == TERMINATED) {
-            unsigned int turnaroundTime = pcb.finishTime - pcb.arrivalTime;
+    for (size_t i = 0; i < pcbTable.size(); i++) {
+        if (pcbTable[i].state == TERMINATED) {
+            const ProcessStats& stats = processStats[i];
+            unsigned int turnaroundTime = stats.finishTime - pcbTable[i].arrivalTime;
             totalTurnaroundTime += turnaroundTime;
-            totalWaitTime += pcb.totalWaitTime;
-            totalResponseTime += pcb.responseTime;
-            totalIOTime += pcb.totalIOTime;
+            totalWaitTime += stats.totalWaitTime;
+            totalResponseTime += stats.responseTime;
+            totalIOTime += stats.totalIOTime;
             processesCompleted++;
         }
     }
 
-    double averageTurnaroundTime = processesCompleted ? static_cast<double>(totalTurnaroundTime) / processesCompleted : 0;
-    double averageWaitTime = processesCompleted ? static_cast<double>(totalWaitTime) / processesCompleted : 0;
-    double averageResponseTime = processesCompleted ? static_cast<double>(totalResponseTime) / processesCompleted : 0;
-    double throughput = currentTime ? static_cast<double>(processesCompleted) / currentTime : 0;
-    double averageIOTime = processesCompleted ? static_cast<double>(totalIOTime) / processesCompleted : 0;
+    SimulationMetrics metrics;
+    metrics.schedulerType = schedulerType;
+    metrics.totalTime = currentTime;
+    metrics.processesCompleted = processesCompleted;
+    metrics.processesRejected = rejectedCount;
+    metrics.averageTurnaroundTime = processesCompleted ? static_cast<double>(totalTurnaroundTime) / processesCompleted : 0;
+    metrics.averageWaitTime = processesCompleted ? static_cast<double>(totalWaitTime) / processesCompleted : 0;
+    metrics.averageResponseTime = processesCompleted ? static_cast<double>(totalResponseTime) / processesCompleted : 0;
+    metrics.throughput = currentTime ? static_cast<double>(processesCompleted) / currentTime : 0;
+    metrics.averageIOTime = processesCompleted ? static_cast<double>(totalIOTime) / processesCompleted : 0;
+    metrics.compactions = compactions;
+    metrics.compactionTime = compactionTime;
+    metrics.latency = latency;
+    for (const auto& core : cores) {
+        metrics.coreUtilization.push_back(currentTime ? static_cast<double>(core.busyTime) / currentTime : 0);
+    }
+    return metrics;
+}
+
+void printPercentiles(const std::string& name, const LatencyHistogram& histogram) {
+    std::cout << name << " Percentiles: p50 " << histogram.percentile(50) << ", p90 " << histogram.percentile(90)
+              << ", p99 " << histogram.percentile(99) << ", p99.9 " << histogram.percentile(99.9)
+              << ", max " << histogram.max() << " ms\n";
+}
+
+void OSSimulator::calculateMetrics() {
+    SimulationMetrics metrics = computeMetrics();
 
     std::cout << "\nSimulation Metrics:\n";
-    std::cout << "Scheduler Type: " << schedulerType << "\n";
-    std::cout << "Total Simulation Time: " << currentTime << " ms\n";
-    std::cout << "Processes Completed: " << processesCompleted << "\n";
-    std::cout << "Throughput: " << throughput << " processes/ms\n";
-    std::cout << "Average Turnaround Time: " << averageTurnaroundTime << " ms\n";
-    std::cout << "Average Wait Time: " << averageWaitTime << " ms\n";
-    std::cout << "Average Response Time: " << averageResponseTime << " ms\n";
-    std::cout << "Average I/O Time: " << averageIOTime << " ms\n";
+    std::cout << "Scheduler Type: " << metrics.schedulerType << "\n";
+    std::cout << "Total Simulation Time: " << metrics.totalTime << " ms\n";
+    std::cout << "Processes Completed: " << metrics.processesCompleted << "\n";
+    if (metrics.processesRejected > 0) {
+        std::cout << "Processes Rejected: " << metrics.processesRejected << "\n";
+    }
+    std::cout << "Throughput: " << metrics.throughput << " processes/ms\n";
+    std::cout << "Average Turnaround Time: " << metrics.averageTurnaroundTime << " ms\n";
+    std::cout << "Average Wait Time: " << metrics.averageWaitTime << " ms\n";
+    std::cout << "Average Response Time: " << metrics.averageResponseTime << " ms\n";
+    std::cout << "Average I/O Time: " << metrics.averageIOTime << " ms\n";
+    if (dynamicMemory) {
+        std::cout << "Compactions: " << metrics.compactions << " (" << metrics.compactionTime << " ms stalled)\n";
+    }
+    printPercentiles("Turnaround Time", metrics.latency.turnaround);
+    printPercentiles("Wait Time", metrics.latency.wait);
+    printPercentiles("Response Time", metrics.latency.response);
+    printPercentiles("I/O Time", metrics.latency.io);
+    if (metrics.coreUtilization.size() > 1) {
+        for (size_t i = 0; i < metrics.coreUtilization.size(); i++) {
+            std::cout << "Core " << i << " Utilization: " << metrics.coreUtilization[i] * 100 << " %\n";
+        }
+    }
 }
 
+#ifndef SIMULATOR_NO_MAIN
 int main(int argc, char** argv) {
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <input_data.txt> [scheduler]\n";
+        std::cerr << "Usage: " << argv[0] << " <input_data.txt> [scheduler] [--event-driven] [--binary-trace] [--partitions <file>] [--quantum <ms>] [--cores <n>]\n"
+                  << "       [--memory <size>] [--compaction-cost <ms per unit>]\n"
+                  << "       [--levels <ms,ms,...>] [--boost <ms>] [--target-latency <ms>] [--min-granularity <ms>]\n";
         return 1;
     }
 
     OSSimulator simulator;
     simulator.loadProcesses(argv[1]);
+    simulator.printLoadStats();
 
     std::string scheduler = "FCFS";
-    if (argc >= 3) {
-        scheduler = argv[2];
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--event-driven") {
+            simulator.setEventDriven(true);
+        } else if (arg == "--binary-trace") {
+            simulator.setBinaryTrace(true);
+        } else if (arg == "--partitions" && i + 1 < argc) {
+            if (!simulator.loadMemoryPartitions(argv[++i])) {
+                std::cerr << "Could not load partitions from " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--memory" && i + 1 < argc) {
+            simulator.setDynamicMemory(std::stoi(argv[++i]));
+        } else if (arg == "--compaction-cost" && i + 1 < argc) {
+            simulator.setCompactionCost(std::stod(argv[++i]));
+        } else if (arg == "--cores" && i + 1 < argc) {
+            simulator.setCoreCount(std::stoi(argv[++i]));
+        } else if (arg == "--quantum" && i + 1 < argc) {
+            simulator.setTimeQuantum(std::stoi(argv[++i]));
+        } else if (arg == "--levels" && i + 1 < argc) {
+            std::vector<unsigned int> quanta;
+            for (const auto& value : utils::split_delim(argv[++i], ",")) quanta.push_back(std::stoi(value));
+            simulator.setLevelQuanta(quanta);
+        } else if (arg == "--boost" && i + 1 < argc) {
+            simulator.setBoostInterval(std::stoi(argv[++i]));
+        } else if (arg == "--target-latency" && i + 1 < argc) {
+            simulator.setTargetLatency(std::stoi(argv[++i]));
+        } else if (arg == "--min-granularity" && i + 1 < argc) {
+            simulator.setMinGranularity(std::stoi(argv[++i]));
+        } else {
+            scheduler = arg;
+        }
+    }
+    if (!OSSimulator::hasScheduler(scheduler)) {
+        std::cerr << "Unknown scheduler " << scheduler << "\n";
+        return 1;
     }
 
     simulator.simulate(scheduler);
     simulator.saveExecution();
     simulator.saveMemoryStatus();
+    if (!simulator.outputFilesOpen()) {
+        std::cerr << "Could not write the execution and memory status tables\n";
+        return 1;
+    }
     simulator.calculateMetrics();
 
     std::cout << "Simulation completed successfully\n";
     return 0;
-}
\ No newline at end of file
+}
+#endif
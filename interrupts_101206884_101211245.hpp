@@ -10,6 +10,18 @@
 #include <algorithm>
 #include <climits>
 #include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <iterator>
+#include <exception>
+#include <queue>
+#include <functional>
+#include <set>
+#include <map>
+#include <utility>
 
 constexpr uint16_t ADDR_BASE = 0x00; // base address for memory
 constexpr uint16_t VECTOR_SIZE = 2;  // size of each vector entry
@@ -23,6 +35,9 @@ namespace utils {
     
     // formats a uint16_t value as a hexadecimal string
     std::string formatHex(uint16_t value);
+
+    // parses a decimal int from [begin, end) like std::stoi, without allocating
+    int parseInt(const char* begin, const char* end);
 }
 
 enum ProcessState { NEW, READY, RUNNING, WAITING, TERMINATED }; // possible states of a process
@@ -36,33 +51,387 @@ struct Partition {
     unsigned int number;   // partition number
     unsigned int size;     // size of the partition
     int occupiedBy;        // pid of the occupying process, -1 if free
+    unsigned int used;     // size of the occupying process, 0 if free
 };
 
+// scheduling state of a process, only what the simulation loop touches so large tables stay cache resident
 struct PCB {
+    PCB* prevInQueue;               // previous process in the queue holding this process
+    PCB* nextInQueue;               // next process in the queue holding this process
     unsigned int pid;               // process identifier
-    std::string programName;        // name of the program
-    unsigned int arrivalTime;       // time when the process arrives
-    unsigned int totalCPUTime;      // total cpu time required
-    unsigned int remainingCPUTime;  // remaining cpu time
-    unsigned int ioFrequency;       // frequency of io operations
-    unsigned int initialIOFrequency; // initial io frequency
-    unsigned int ioDuration;        // duration of io operations
-    unsigned int initialIODuration; // initial io duration
-    unsigned int nextIOTime;        // time until next io
-    unsigned int partitionNumber;   // partition number where the process is located
     ProcessState state;             // current state of the process
-    unsigned int size;              // memory size required by the process
+    unsigned int remainingCPUTime;  // remaining cpu time
+    unsigned int nextIOTime;        // cpu time until the next io operation
+    unsigned int ioFrequency;       // cpu time between io operations
+    unsigned int ioDuration;        // duration of each io operation
     unsigned int priority;          // priority of the process for priority scheduling
-    unsigned int lastScheduledTime; // last time the process was scheduled
-    unsigned int totalWaitTime;     // total time spent in the ready queue
-    unsigned int startTime;         // time when the process started execution
+    unsigned int core;              // core whose ready queue the process joins
+    unsigned int level;             // feedback queue level, 0 runs first
+    unsigned int size;              // memory size required by the process
+    unsigned int partitionNumber;   // partition number where the process is located, block offset in dynamic memory mode
+    unsigned int arrivalTime;       // time when the process arrives
+    unsigned int wakeTime;          // time when the current io operation completes
+    unsigned long timerOrder;       // order in which io operations were started, breaks wakeTime ties
+    unsigned long long vruntime;    // cpu time weighted by priority, for the fair scheduler
+};
+
+// name and statistics of a process, kept apart from its PCB since only state transitions and metrics use them
+struct ProcessStats {
+    std::string programName;        // name of the program
+    unsigned int totalCPUTime;      // total cpu time required
+    unsigned int startTime;         // time when the process was admitted to memory
     unsigned int finishTime;        // time when the process finished execution
     unsigned int responseTime;      // time from arrival to first execution
     bool hasStarted;                // flag indicating if the process has started execution
+    unsigned int lastScheduledTime; // last time the process was scheduled
+    unsigned int readySince;        // time when the process last joined a ready queue
+    unsigned int totalWaitTime;     // total time spent in the ready queue, added when the process is dispatched
+    unsigned int ioStartTime;       // time when the current io operation started
     unsigned int totalIOTime;       // total time spent performing io operations
     unsigned int numberOfIO;        // number of io operations performed
 };
 
+// intrusive doubly linked list of processes, a process can be in only one list at a time
+class ProcessList {
+private:
+    PCB* head;    // first process in the list
+    PCB* tail;    // last process in the list
+    size_t count; // number of processes in the list
+
+public:
+    // constructor that creates an empty list
+    ProcessList();
+
+    // appends a process to the end of the list
+    void pushBack(PCB* pcb);
+
+    // removes and returns the first process, nullptr if empty
+    PCB* popFront();
+
+    // unlinks a process from anywhere in the list
+    void remove(PCB* pcb);
+
+    // moves every process of other to the end of this list, leaving other empty
+    void append(ProcessList& other);
+
+    // gets the first process, follow nextInQueue to walk the list
+    PCB* front() const;
+
+    // checks if the list is empty
+    bool empty() const;
+
+    // number of processes in the list
+    size_t size() const;
+};
+
+// hierarchical timer wheel of processes keyed by absolute wake time
+// level k holds processes whose wake time first differs from the current time in its k-th group of SLOT_BITS bits,
+// so advancing only re-files the one slot whose group was reached and a tick never touches processes that keep sleeping
+class TimerWheel {
+private:
+    static constexpr unsigned int SLOT_BITS = 8;                        // bits of the wake time resolved per level
+    static constexpr unsigned int SLOTS = 1u << SLOT_BITS;              // slots per level
+    static constexpr unsigned int LEVELS = 32 / SLOT_BITS;              // levels needed for 32 bit times
+
+    std::vector<ProcessList> slots; // LEVELS * SLOTS lists of sleeping processes
+    unsigned int now;               // time of the last advance
+    unsigned long nextOrder;        // timerOrder given to the next scheduled process
+    size_t count;                   // number of sleeping processes
+
+    // files a process in the slot matching its wake time relative to now
+    void place(PCB* pcb);
+
+public:
+    // constructor that creates an empty wheel at time 0
+    TimerWheel();
+
+    // puts a process to sleep until a time after the current one
+    void schedule(PCB* pcb, unsigned int wakeTime);
+
+    // moves the wheel to a later time and returns the processes waking then, in the order they were scheduled
+    // no process may have a wake time between the previous advance and this one
+    void advance(unsigned int time, std::vector<PCB*>& woken);
+
+    // checks if no process is sleeping
+    bool empty() const;
+
+    // calls fn on every sleeping process
+    template <typename Function>
+    void forEach(Function fn) const {
+        for (const auto& slot : slots) {
+            for (PCB* pcb = slot.front(); pcb != nullptr; pcb = pcb->nextInQueue) fn(pcb);
+        }
+    }
+
+    // number of sleeping processes
+    size_t size() const;
+};
+
+// buddy allocator over memory units [0, total), every block is a power of two aligned to its size
+class BuddyAllocator {
+private:
+    struct Block {
+        unsigned int order; // the block holds 2^order units
+        PCB* owner;         // process using the block, nullptr if free
+    };
+
+    std::map<unsigned int, Block> blocks;           // every block by offset, free or allocated
+    std::vector<std::set<unsigned int> > freeBlocks; // offsets of the free blocks of each order
+    std::vector<unsigned int> allocatedBlocks;      // number of allocated blocks of each order
+    unsigned int total;                             // units managed by the allocator
+    unsigned int allocated;                         // units in allocated blocks
+    unsigned int requested;                         // units requested by the owners of allocated blocks
+
+    // adds a free block without coalescing it
+    void addFree(unsigned int offset, unsigned int order);
+
+    // marks the lowest free block of the order as owned by pcb, splitting larger blocks if needed
+    bool allocateOrder(unsigned int order, PCB* pcb, unsigned int& offset);
+
+public:
+    static constexpr unsigned int ORDERS = 32; // block sizes from 1 to 2^31 units
+
+    // constructor that creates an allocator without memory
+    BuddyAllocator();
+
+    // frees everything and manages total units, split into aligned power of two blocks
+    void reset(unsigned int total);
+
+    // smallest order whose block holds size units
+    static unsigned int orderFor(unsigned int size);
+
+    // gives pcb the lowest addressed block of the smallest order that fits its size, false if none is free
+    bool allocate(PCB* pcb, unsigned int& offset);
+
+    // frees the block at offset and merges it with its free buddies
+    void release(unsigned int offset);
+
+    // repacks the allocated blocks from the lowest address, largest first, and returns the units moved
+    // owners of moved blocks get their new offset in partitionNumber
+    unsigned long compact();
+
+    // units managed by the allocator
+    unsigned int totalSize() const { return total; }
+
+    // number of free and allocated blocks
+    size_t blockCount() const { return blocks.size(); }
+
+    // units in allocated blocks, including what their owners do not use
+    unsigned int allocatedSize() const { return allocated; }
+
+    // units the owners of allocated blocks asked for
+    unsigned int requestedSize() const { return requested; }
+
+    // size of the largest free block, 0 if none is free
+    unsigned int largestFree() const;
+
+    // size of the largest free block compact would leave, 0 if none
+    unsigned int largestFreeAfterCompaction() const;
+
+    // size of the largest block the allocator could ever hand out
+    unsigned int largestBlock() const { return total == 0 ? 0 : 1u << (31 - __builtin_clz(total)); }
+
+    // calls fn(offset, size, owner) on every block in address order, owner is nullptr for free blocks
+    template <typename Function>
+    void forEachBlock(Function fn) const {
+        for (const auto& block : blocks) fn(block.first, 1u << block.second.order, block.second.owner);
+    }
+};
+
+class ReadyQueue {
+private:
+    struct Entry {
+        unsigned long long key; // scheduling key of the process, lower values run first
+        unsigned long order;    // insertion order, used to break key ties first come first served
+        PCB* pcb;               // the ready process
+    };
+
+    std::vector<Entry> entries; // binary heap of queued processes when ordered by key
+    std::vector<ProcessList> levels; // first come first served lists when not keyed, the key picks the list
+    uint64_t occupiedLevels;    // bit i is set while levels[i] is not empty
+    size_t levelCount;          // number of processes in all levels
+    bool keyed;                 // pop the process with the lowest key instead of the oldest one
+    unsigned long nextOrder;    // insertion order given to the next pushed process
+
+    // heap comparison, true if a should be dispatched after b
+    static bool runsAfter(const Entry& a, const Entry& b);
+
+public:
+    static constexpr unsigned int MAX_LEVELS = 64; // levels tracked by the occupiedLevels bitmap
+
+    // constructor that creates an empty first come first served queue
+    ReadyQueue();
+
+    // switches between first come first served and key order, only valid while empty
+    void setKeyed(bool enabled);
+
+    // sets the number of first come first served levels used when not keyed, only valid while empty
+    void setLevels(unsigned int count);
+
+    // adds a process to the queue, when not keyed the key is the level and lower levels are served first
+    void push(PCB* pcb, unsigned long long key = 0);
+
+    // removes and returns the next process to dispatch, nullptr if empty
+    PCB* pop();
+
+    // key or level of the next process to dispatch, only valid when not empty
+    unsigned long long topKey() const;
+
+    // moves every queued process to level 0 and sets its level to 0, keeping level order
+    void mergeLevels();
+
+    // checks if the queue is empty
+    bool empty() const;
+
+    // number of queued processes
+    size_t size() const;
+};
+
+namespace fair {
+    // load weight of a priority, each priority step gets about 1.25 times less cpu than the one before
+    unsigned int weight(unsigned int priority);
+
+    // virtual runtime charged for 1 ms of cpu, 1000 for priority 0
+    unsigned long long vruntimePerMs(unsigned int priority);
+}
+
+// streams formatted rows to a file through a fixed size buffer
+class TraceWriter {
+private:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024; // bytes buffered before writing to the file
+
+    std::ofstream file;       // output file
+    std::vector<char> buffer; // pending bytes not yet written to the file
+    size_t used;              // number of pending bytes in the buffer
+
+public:
+    // constructor that allocates the buffer, no file is open yet
+    TraceWriter();
+
+    // flushes pending bytes before closing the file
+    ~TraceWriter();
+
+    // opens a file for writing, truncating it
+    bool open(const std::string& filename);
+
+    // appends raw text
+    void write(const char* data, size_t length);
+
+    // appends text up to its terminator, so literal headers are not copied into a std::string first
+    void write(const char* text);
+
+    // gets space for a row of at most length bytes, length must not exceed the buffer size
+    char* reserve(size_t length);
+
+    // marks length bytes of the reserved space as written
+    void commit(size_t length);
+
+    // writes pending bytes to the file
+    void flush();
+};
+
+// binary traces are a file header followed by fixed width records in host byte order, so they can be memory mapped
+const char EXECUTION_TRACE_MAGIC[] = "OSEXEC01";
+const char MEMORY_TRACE_MAGIC[] = "OSMEMS01";
+const char BLOCK_MEMORY_TRACE_MAGIC[] = "OSMEMB01"; // dynamic memory, whose records vary with the number of blocks
+
+struct TraceFileHeader {
+    char magic[8];           // EXECUTION_TRACE_MAGIC or MEMORY_TRACE_MAGIC without the terminator
+    uint32_t recordSize;     // size in bytes of every record
+    uint32_t partitionCount; // partitions per memory record, followed by that many uint32_t partition sizes; 0 for execution traces
+};
+
+struct TransitionRecord {
+    uint32_t time;      // time of transition
+    uint32_t pid;       // process identifier
+    uint8_t oldState;   // ProcessState before the transition
+    uint8_t newState;   // ProcessState after the transition
+    uint8_t padding[2]; // always zero
+};
+
+struct MemoryStatusRecord {
+    uint32_t time;              // time of the event
+    uint32_t memoryUsed;        // memory held by processes
+    uint32_t totalFreeMemory;   // memory not held by any process
+    uint32_t usableFreeMemory;  // free memory that can still be allocated
+    // followed by partitionCount int32_t pids occupying each partition, -1 if free
+    // in a BLOCK_MEMORY_TRACE_MAGIC trace followed by a uint32_t block count and that many int32_t pids in address order
+};
+
+namespace tables {
+    // names of the process states as printed in the execution table, indexed by ProcessState
+    constexpr const char* STATE_NAMES[] = {"NEW", "READY", "RUNNING", "WAITING", "TERMINATED"};
+
+    // name of a process state as printed in the execution table
+    constexpr const char* stateName(ProcessState state) { return STATE_NAMES[state]; }
+
+    // writes the decimal digits of value and returns the end of them
+    char* writeUnsigned(char* out, unsigned int value);
+
+    // writes value in decimal with a leading minus if negative and returns the end of it
+    char* writeInt(char* out, int value);
+
+    // copies text without its terminator and returns the end of it
+    char* writeText(char* out, const char* text);
+
+    // pads the column that starts at start with spaces to width, like setw with left, and returns its end
+    char* padColumn(char* start, char* end, size_t width);
+
+    // writes the execution table header
+    void writeExecutionHeader(TraceWriter& out);
+
+    // writes one state transition row of the execution table
+    void writeExecutionRow(TraceWriter& out, unsigned int time, unsigned int pid, ProcessState oldState, ProcessState newState);
+
+    // writes the execution table footer
+    void writeExecutionFooter(TraceWriter& out);
+
+    // writes the memory status table header
+    void writeMemoryStatusHeader(TraceWriter& out);
+
+    // writes the time and memory used columns that start a memory status row
+    void writeMemoryStatusStart(TraceWriter& out, unsigned int time, unsigned int memoryUsed);
+
+    // writes the pid of one partition or block, -1 if free, and returns how many characters of the partitions column it took
+    size_t writeMemoryStatusCell(TraceWriter& out, int pid, bool first);
+
+    // pads the partitions column to its width and writes the free memory columns that end a memory status row
+    void writeMemoryStatusEnd(TraceWriter& out, size_t partitionsLength, unsigned int totalFreeMemory, unsigned int usableFreeMemory);
+
+    // writes one row of the memory status table
+    void writeMemoryStatusRow(TraceWriter& out, unsigned int time, unsigned int memoryUsed, const std::vector<int>& partitionsState,
+                              unsigned int totalFreeMemory, unsigned int usableFreeMemory);
+
+    // writes the memory status table footer
+    void writeMemoryStatusFooter(TraceWriter& out);
+}
+
+// read only memory mapping of a whole file
+class MappedFile {
+private:
+    const char* bytes; // start of the mapping, nullptr if nothing is mapped
+    size_t length;     // size of the file in bytes
+
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+public:
+    // constructor that creates an empty mapping
+    MappedFile();
+
+    // unmaps the file
+    ~MappedFile();
+
+    // maps a file, false if it cannot be opened
+    bool open(const std::string& filename);
+
+    // gets the first byte of the file
+    const char* data() const;
+
+    // gets the size of the file in bytes
+    size_t size() const;
+};
+
 class VectorTable {
 private:
     std::vector<uint16_t> addresses; // list of isr addresses
@@ -84,20 +453,236 @@ public:
     uint16_t getMemoryPosition(uint16_t interrupt_num) const;
 };
 
+// counts of ms values in log buckets split into linear sub-buckets, so any percentile is within 1% using fixed memory
+class LatencyHistogram {
+public:
+    static constexpr unsigned int SUB_BUCKET_BITS = 8;                     // linear sub-buckets per power of two, as bits
+    static constexpr unsigned int SUB_BUCKETS = 1u << SUB_BUCKET_BITS;    // values below this get a bucket each
+    static constexpr unsigned int BUCKETS = (34 - SUB_BUCKET_BITS) * (SUB_BUCKETS / 2); // buckets covering every unsigned int
+
+    // constructor that creates an empty histogram
+    LatencyHistogram();
+
+    // counts one value
+    void record(unsigned int value);
+
+    // adds the counts of another histogram, as if its values had been recorded here
+    void merge(const LatencyHistogram& other);
+
+    // number of recorded values
+    unsigned long long count() const { return total; }
+
+    // largest recorded value, 0 if none
+    unsigned int max() const { return maximum; }
+
+    // smallest value at or above the given percent of the recorded values, to bucket precision, 0 if none
+    unsigned int percentile(double percent) const;
+
+private:
+    std::vector<unsigned long long> buckets; // count of values in each bucket
+    unsigned long long total;                // number of recorded values
+    unsigned int maximum;                    // largest recorded value
+
+    // bucket holding a value
+    static unsigned int bucketOf(unsigned int value);
+
+    // largest value held by a bucket
+    static unsigned int highestInBucket(unsigned int bucket);
+};
+
+// tail latency of the terminated processes, one histogram per metric
+struct LatencyHistograms {
+    LatencyHistogram turnaround; // time from arrival to termination
+    LatencyHistogram wait;       // time spent in the ready queue
+    LatencyHistogram response;   // time from arrival to first dispatch
+    LatencyHistogram io;         // time spent performing io
+
+    // adds the counts of another run
+    void merge(const LatencyHistograms& other);
+};
+
+// prints p50, p90, p99, p99.9 and the maximum of a histogram as one line of the metrics report
+void printPercentiles(const std::string& name, const LatencyHistogram& histogram);
+
+struct SimulationMetrics {
+    std::string schedulerType;    // scheduler used for the run
+    unsigned int totalTime;       // total simulation time in ms
+    unsigned int processesCompleted; // number of terminated processes
+    unsigned int processesRejected; // number of processes too large to ever fit in memory
+    double throughput;            // processes completed per ms
+    double averageTurnaroundTime; // mean time from arrival to termination
+    double averageWaitTime;       // mean time spent in the ready queue
+    double averageResponseTime;   // mean time from arrival to first dispatch
+    double averageIOTime;         // mean time spent performing io
+    unsigned int compactions;     // memory compaction passes in dynamic memory mode
+    unsigned int compactionTime;  // ms the cpus were stalled by compaction
+    std::vector<double> coreUtilization; // fraction of the run each core spent running processes
+    LatencyHistograms latency;    // percentiles of the per process times
+};
+
+struct Core {
+    ReadyQueue readyQueue;         // processes waiting for this core
+    PCB* runningProcess;           // process on this core, nullptr if idle
+    unsigned int currentTimeSlice; // time the running process has used of its quantum
+    unsigned long busyTime;        // ms this core spent running processes
+    unsigned long long readyWeight; // sum of the fair scheduler weights of the queued processes
+    unsigned long long minVruntime; // lowest virtual runtime seen on this core, never decreases
+};
+
+// tunables of the schedulers, read by the policy hooks
+struct SchedulerSettings {
+    unsigned int timeQuantum;              // time quantum for round robin
+    std::vector<unsigned int> levelQuanta; // time quantum of each feedback queue level
+    unsigned int boostInterval;            // ms between moves of every process to feedback level 0, 0 to disable
+    unsigned int targetLatency;            // ms in which the fair scheduler runs every ready process once
+    unsigned int minGranularity;           // shortest fair scheduler quantum in ms
+};
+
+// default hooks of a scheduling policy, the simulation loop is instantiated once per policy and only calls these
+// a policy derives from this struct and hides the hooks it changes, so a new scheduler never touches the loop
+struct SchedulingPolicy {
+    static constexpr unsigned int NO_QUANTUM = UINT_MAX; // quantum of a process that is not time sliced
+    static constexpr bool keyed = false; // ready queue is ordered by readyKey instead of first come first served
+
+    // key of a ready process, lower keys run first; the level of the ready queue when not keyed
+    static unsigned long long readyKey(const PCB&) { return 0; }
+
+    // number of first come first served levels of the ready queue when not keyed
+    static unsigned int levels(const SchedulerSettings&) { return 1; }
+
+    // called before a process joins the ready queue of a core
+    static void onReady(Core&, PCB&) {}
+
+    // called after a process left the ready queue of a core, to run there or on a core that stole it
+    static void onDequeue(Core&, PCB&) {}
+
+    // time slice of the process running on a core, NO_QUANTUM if it keeps the core until it blocks or is preempted
+    static unsigned int quantum(const Core&, const SchedulerSettings&) { return NO_QUANTUM; }
+
+    // checks if a queued process takes the core from the running process right away
+    static bool preempts(const Core&) { return false; }
+
+    // called for the ms a process ran, more than one at once when the event driven engine skips ahead
+    static void onRun(PCB&, unsigned int) {}
+
+    // called when a process used up its quantum, before it goes back to the ready queue
+    static void onQuantumExpired(PCB&, const SchedulerSettings&) {}
+
+    // called when a process finished its io, before it goes back to the ready queue
+    static void onIOComplete(PCB&) {}
+
+    // ms between calls of onPeriod, 0 for never
+    static unsigned int period(const SchedulerSettings&) { return 0; }
+
+    // called every period ms with every core and the processes sleeping on io
+    static void onPeriod(std::vector<Core>&, TimerWheel&) {}
+
+protected:
+    // checks if the next queued process of a core has a lower key than the running one
+    static bool lowerKeyQueued(const Core& core, unsigned long long runningKey) {
+        return !core.readyQueue.empty() && core.readyQueue.topKey() < runningKey;
+    }
+};
+
+struct FCFSPolicy : SchedulingPolicy {};
+
+struct EPPolicy : SchedulingPolicy {
+    static constexpr bool keyed = true;
+    static unsigned long long readyKey(const PCB& pcb) { return pcb.priority; }
+};
+
+struct RRPolicy : SchedulingPolicy {
+    static unsigned int quantum(const Core&, const SchedulerSettings& settings) { return settings.timeQuantum; }
+};
+
+// shortest job first, the process with the least remaining cpu time runs to its next io or termination
+struct SJFPolicy : SchedulingPolicy {
+    static constexpr bool keyed = true;
+    static unsigned long long readyKey(const PCB& pcb) { return pcb.remainingCPUTime; }
+};
+
+// shortest remaining time first, the running process is outside the heap so burning cpu never changes a queued key
+struct SRTFPolicy : SchedulingPolicy {
+    static constexpr bool keyed = true;
+    static unsigned long long readyKey(const PCB& pcb) { return pcb.remainingCPUTime; }
+    static bool preempts(const Core& core) { return lowerKeyQueued(core, readyKey(*core.runningProcess)); }
+};
+
+// multilevel feedback queue, demoted on quantum expiry, promoted after io and boosted to level 0 periodically
+struct MLFQPolicy : SchedulingPolicy {
+    static unsigned long long readyKey(const PCB& pcb) { return pcb.level; }
+    static unsigned int levels(const SchedulerSettings& settings) { return settings.levelQuanta.size(); }
+    static unsigned int quantum(const Core& core, const SchedulerSettings& settings) {
+        return settings.levelQuanta[core.runningProcess->level];
+    }
+    static bool preempts(const Core& core) { return lowerKeyQueued(core, readyKey(*core.runningProcess)); }
+    static void onQuantumExpired(PCB& pcb, const SchedulerSettings& settings);
+    static void onIOComplete(PCB& pcb) { if (pcb.level > 0) pcb.level--; }
+    static unsigned int period(const SchedulerSettings& settings) { return settings.boostInterval; }
+    static void onPeriod(std::vector<Core>& cores, TimerWheel& sleeping);
+};
+
+// completely fair scheduler, the process with the least weighted cpu time runs next
+struct CFSPolicy : SchedulingPolicy {
+    static constexpr bool keyed = true;
+    static unsigned long long readyKey(const PCB& pcb) { return pcb.vruntime; }
+    static void onReady(Core& core, PCB& pcb);
+    static void onDequeue(Core& core, PCB& pcb) { core.readyWeight -= fair::weight(pcb.priority); }
+    static unsigned int quantum(const Core& core, const SchedulerSettings& settings);
+    static void onRun(PCB& pcb, unsigned int ms) { pcb.vruntime += ms * fair::vruntimePerMs(pcb.priority); }
+};
+
 class OSSimulator {
 private:
+    friend class SimulatorBenchmark;         // benchmarks time the private hot paths directly
+
     VectorTable* vectorTable;                // pointer to the vector table
     std::vector<Partition> memoryPartitions; // list of memory partitions
+    unsigned int largestPartition;           // size of the largest partition
+    std::set<std::pair<unsigned int, unsigned int> > freePartitions; // free partitions as (size, index), smallest first
     std::vector<PCB> pcbTable;               // table of process control blocks
+    std::vector<ProcessStats> processStats;  // names and statistics of the processes, same index as pcbTable
+    std::vector<unsigned int> arrivalOrder;  // pcbTable indices sorted by arrival time, ties in table order
+    size_t nextArrival;                      // position in arrivalOrder of the next process to arrive
+    size_t terminatedCount;                  // number of processes that have terminated
+    size_t rejectedCount;                    // number of processes too large to ever fit in memory
     unsigned int nextPID;                    // next available process id
     unsigned int currentTime;                // current simulation time
-    std::string executionLog;                // log of process state transitions
-    std::string memoryStatusLog;             // log of memory status over time
+    std::string executionFile;               // path of the execution table
+    std::string memoryStatusFile;            // path of the memory status table
+    TraceWriter executionTrace;              // streams process state transitions to executionFile
+    TraceWriter memoryStatusTrace;           // streams memory status over time to memoryStatusFile
+    bool outputOpen;                         // both output files could be opened
+    unsigned int usedMemory;                 // memory held by processes, partitions or blocks included
+    unsigned int totalFreeMemory;            // memory not used by any process
+    unsigned int usableFreeMemory;           // memory in free partitions or blocks
+    bool memoryStatusStarted;                // set once the memory status header has been written
+    bool binaryTrace;                        // write binary traces instead of text tables
+    size_t loadedBytes;                      // bytes of input parsed by loadProcesses
+    double loadSeconds;                      // wall time spent in loadProcesses
+    unsigned long dispatches;                // number of scheduling decisions made
     std::mt19937 rng;                        // random number generator
     std::uniform_int_distribution<> execTimeDistr; // distribution for execution times
     std::string schedulerType;               // type of scheduler being used
+    TimerWheel waitingQueue;                 // processes blocked on io, keyed by completion time
+    std::vector<PCB*> ioCompletions;         // processes whose io completes in the current tick
+    std::vector<ProcessList> memoryWaitQueue; // processes waiting for memory, by size class, in arrival order within a class
+    size_t memoryWaiting;                    // number of processes in memoryWaitQueue
+    bool memoryFreed;                        // memory was released or compacted since waiting processes were last retried
+    bool dynamicMemory;                      // allocate from buddyMemory instead of the partition table
+    BuddyAllocator buddyMemory;              // memory of the dynamic memory mode
+    double compactionCost;                   // ms charged per memory unit moved by compaction, 0 disables compaction
+    unsigned int compactionUntil;            // the cpus do no work before this time while memory is compacted
+    unsigned int compactions;                // compaction passes so far
+    unsigned int compactionTime;             // ms of compaction charged so far
+    bool memoryCompacted;                    // nothing was freed since the last compaction, so another one cannot help
+    LatencyHistograms latency;               // times of the terminated processes, recorded as each one terminates
+    std::vector<Core> cores;                 // simulated cpus, each with its own ready queue
+    SchedulerSettings settings;              // tunables of the schedulers
+    bool eventDriven;                        // jump to the next event instead of ticking every ms
+    std::priority_queue<unsigned int, std::vector<unsigned int>, std::greater<unsigned int> > pendingEvents; // times at which something can happen
 
-    // clears the output files by truncating them
+    // clears the output files by truncating them and opens them for streaming
     void clearOutputFiles();
     
     // generates a random execution time
@@ -106,25 +691,174 @@ private:
     // checks if a process is a child process based on its pid
     bool isChildProcess(unsigned int pid);
     
+    // parses one line of the input file, false if the line is empty or has fewer than 6 fields
+    static bool parseProcessLine(const char* begin, const char* end, PCB& pcb, ProcessStats& stats);
+
+    // parses every line in [begin, end) and appends the processes to pcbs and their statistics to stats
+    static void parseProcessChunk(const char* begin, const char* end, std::vector<PCB>& pcbs, std::vector<ProcessStats>& stats);
+
     // initializes memory partitions with predefined sizes
     void initializeMemoryPartitions();
+
+    // replaces the partition table with free partitions of the given sizes
+    void setPartitionSizes(const std::vector<unsigned int>& sizes);
     
     // finds the best fit partition for a given process size
     int findBestFitPartition(unsigned int size);
+
+    // gives a free partition to a process
+    void allocatePartition(int partitionIndex, PCB* pcb);
+
+    // frees the partition held by a process
+    void releasePartition(PCB* pcb);
+
+    // gives memory to a process from the partition table or the buddy allocator, compacting if that helps
+    bool allocateMemory(PCB* pcb);
+
+    // frees the memory held by a process
+    void releaseMemory(PCB* pcb);
+
+    // compacts the buddy allocator and stalls the cpus for the cost of the move
+    void compactMemory();
+
+    // takes the running memory totals from the buddy allocator
+    void countDynamicMemory();
+
+    // takes the running memory totals from the partition table
+    void countPartitionMemory();
     
     // logs the state transition of a process
-    void logStateTransition(unsigned int time, unsigned int pid, const std::string& oldState, const std::string& newState);
+    void logStateTransition(unsigned int time, unsigned int pid, ProcessState oldState, ProcessState newState);
     
     // saves the current memory status to the memory status log
     void saveMemoryStatus(unsigned int time);
 
+    // reopens the logs with a .bin extension and writes their file headers
+    void openBinaryTraces();
+
+    // checks if every process has terminated or was rejected
+    bool allProcessesTerminated() const;
+
+    // checks if anything is left that can run, arrive, finish io or free memory
+    bool canProgress() const;
+
+    struct SchedulerEntry {
+        const char* name;             // scheduler name given to simulate
+        void (OSSimulator::*run)();   // simulation loop instantiated for the scheduler's policy
+    };
+    static const SchedulerEntry schedulers[]; // every supported scheduler
+
+    // runs the simulation loop until every process has terminated
+    template <typename Policy>
+    void runSimulation();
+
+    // runs one millisecond of the simulation at the current time
+    template <typename Policy>
+    void runTick();
+
+    // puts a ready process on the queue of a core
+    template <typename Policy>
+    void makeReady(PCB* pcb, unsigned int core);
+
+    // moves a process that just got memory from NEW to READY
+    template <typename Policy>
+    void admit(PCB* pcb);
+
+    // retries the waiting processes of every size class that could fit, in arrival order across classes
+    template <typename Policy>
+    void admitWaiting();
+
+    // size of the largest process allocateMemory could place right now
+    unsigned int largestAdmissible() const;
+
+    // checks if a process of the given size fits in memory once every other process is gone
+    bool canEverFit(unsigned int size) const;
+
+    // size class of a process in memoryWaitQueue, class c holds sizes up to 2^c
+    static unsigned int sizeClass(unsigned int size) { return BuddyAllocator::orderFor(size); }
+
+    // statistics of a process in pcbTable
+    ProcessStats& statsOf(const PCB* pcb);
+
+    // finds the core with the least queued and running work
+    unsigned int leastLoadedCore() const;
+
+    // takes a process from the core with the most queued work for an idle core, nullptr if there is none
+    template <typename Policy>
+    PCB* stealWork(unsigned int thief);
+
+    // removes the next process from the queue of a core, nullptr if empty
+    template <typename Policy>
+    PCB* takeReady(Core& core);
+
+    // checks if an idle core could pick up a queued process
+    bool idleCoreCanDispatch() const;
+
+    // records a time at which the event driven engine must run a tick
+    void scheduleEvent(unsigned int time);
+
+    // pops the earliest pending event after the current time, false if there is none
+    bool nextEventTime(unsigned int& time);
+
+    // applies the effect of a number of ticks in which no event happens
+    template <typename Policy>
+    void skipIdleTicks(unsigned int ticks);
+
 public:
-    // constructor that initializes the simulator
+    // constructor that initializes the simulator, writing to execution.txt and memory_status.txt
     OSSimulator();
+
+    // constructor that initializes the simulator with its own output files
+    OSSimulator(const std::string& executionFile, const std::string& memoryStatusFile);
     
+    // loads partition sizes from a file, separated by commas or new lines
+    bool loadMemoryPartitions(const std::string& filename);
+
+    // switches to dynamic memory of the given size in units managed by a buddy allocator, 0 goes back to the partition table
+    void setDynamicMemory(unsigned int totalSize);
+
+    // sets the ms charged per memory unit moved by compaction in dynamic memory mode, 0 disables compaction
+    void setCompactionCost(double msPerUnit);
+
+    // writes binary traces instead of text tables
+    void setBinaryTrace(bool enabled);
+
+    // sets the round robin time quantum in ms
+    void setTimeQuantum(unsigned int quantum);
+
+    // sets the quantum of each feedback queue level in ms, one level per value up to ReadyQueue::MAX_LEVELS
+    void setLevelQuanta(const std::vector<unsigned int>& quanta);
+
+    // sets the feedback queue priority boost interval in ms, 0 disables it
+    void setBoostInterval(unsigned int interval);
+
+    // sets the time in ms in which the fair scheduler aims to run every ready process once
+    void setTargetLatency(unsigned int latency);
+
+    // sets the shortest fair scheduler quantum in ms
+    void setMinGranularity(unsigned int granularity);
+
+    // sets the number of simulated cpus, at least 1
+    void setCoreCount(unsigned int count);
+
+    // enables or disables the event driven engine
+    void setEventDriven(bool enabled);
+
     // loads processes from an input file and initializes the pcb table
     void loadProcesses(const std::string& filename);
     
+    // prints how many processes were loaded and the parse throughput
+    void printLoadStats() const;
+
+    // checks if the execution and memory status files could be opened for writing
+    bool outputFilesOpen() const;
+
+    // number of processes in the pcb table
+    size_t processCount() const;
+
+    // true if simulate() knows the named scheduler
+    static bool hasScheduler(const std::string& schedulerType);
+
     // runs the simulation based on the specified scheduler type
     void simulate(const std::string& schedulerType);
     
@@ -134,6 +868,9 @@ public:
     // saves the memory status log to a file
     void saveMemoryStatus();
     
+    // calculates the simulation metrics
+    SimulationMetrics computeMetrics() const;
+
     // calculates and displays simulation metrics
     void calculateMetrics();
 };
@@ -0,0 +1,213 @@
+#define SIMULATOR_NO_MAIN
+#include "interrupts_101206884_101211245.cpp"
+
+#include <atomic>
+#include <cerrno>
+#include <map>
+#include <mutex>
+#include <sys/stat.h>
+
+struct SweepRun {
+    std::string input;      // workload file
+    std::string scheduler;  // name of a supported scheduler
+    unsigned int quantum;   // round robin time quantum, only varied for RR
+    std::string partitions; // partition file, "default" for the built in table
+    std::string name;       // prefix of the output files of this run
+    bool ok;                // false if the run could not be completed
+    std::string error;      // why the run failed
+    SimulationMetrics metrics; // results of the run
+    double seconds;         // wall time of the run
+};
+
+// base name of a path without directories or extension
+std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+// runs one simulator instance with its own output files
+void runOne(SweepRun& run, const std::string& outputDir, bool eventDriven) {
+    auto start = std::chrono::steady_clock::now();
+    try {
+        if (!OSSimulator::hasScheduler(run.scheduler)) {
+            throw std::runtime_error("unknown scheduler " + run.scheduler);
+        }
+        OSSimulator simulator(outputDir + "/" + run.name + "_execution.txt",
+                              outputDir + "/" + run.name + "_memory_status.txt");
+        if (!simulator.outputFilesOpen()) {
+            throw std::runtime_error("could not open the output files in " + outputDir);
+        }
+        simulator.setEventDriven(eventDriven);
+        simulator.setTimeQuantum(run.quantum);
+        if (run.partitions != "default" && !simulator.loadMemoryPartitions(run.partitions)) {
+            throw std::runtime_error("could not load partitions from " + run.partitions);
+        }
+        simulator.loadProcesses(run.input);
+        if (simulator.processCount() == 0) {
+            throw std::runtime_error("no processes loaded from " + run.input);
+        }
+        simulator.simulate(run.scheduler);
+        simulator.saveExecution();
+        simulator.saveMemoryStatus();
+        run.metrics = simulator.computeMetrics();
+        run.ok = true;
+    } catch (const std::exception& e) {
+        run.ok = false;
+        run.error = e.what();
+    }
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// prints the consolidated metrics of every run and writes them as csv, false if the csv could not be written
+bool reportRuns(const std::vector<SweepRun>& runs, const std::string& csvFile) {
+    std::ofstream csv(csvFile);
+    csv << "input,scheduler,quantum,partitions,status,total_time,completed,throughput,"
+           "avg_turnaround,avg_wait,avg_response,avg_io,p99_turnaround,p99_wait,p99_response,wall_seconds\n";
+
+    std::cout << std::left << std::setw(24) << "Input" << std::setw(6) << "Sched" << std::setw(8) << "Quantum"
+              << std::setw(16) << "Partitions" << std::setw(12) << "Time" << std::setw(10) << "Done"
+              << std::setw(14) << "Turnaround" << std::setw(12) << "Wait" << std::setw(12) << "Response" << "\n";
+    for (const auto& run : runs) {
+        std::string quantum = run.scheduler == "RR" ? std::to_string(run.quantum) : "-";
+        csv << run.input << "," << run.scheduler << "," << quantum << "," << run.partitions << ","
+            << (run.ok ? "ok" : "failed") << ",";
+        std::cout << std::setw(24) << baseName(run.input) << std::setw(6) << run.scheduler << std::setw(8) << quantum
+                  << std::setw(16) << baseName(run.partitions);
+        if (!run.ok) {
+            csv << ",,,,,,,,,," << run.seconds << "\n";
+            std::cout << "failed: " << run.error << "\n";
+            continue;
+        }
+        const SimulationMetrics& m = run.metrics;
+        csv << m.totalTime << "," << m.processesCompleted << "," << m.throughput << "," << m.averageTurnaroundTime << ","
+            << m.averageWaitTime << "," << m.averageResponseTime << "," << m.averageIOTime << ","
+            << m.latency.turnaround.percentile(99) << "," << m.latency.wait.percentile(99) << ","
+            << m.latency.response.percentile(99) << "," << run.seconds << "\n";
+        std::cout << std::setw(12) << m.totalTime << std::setw(10) << m.processesCompleted
+                  << std::setw(14) << m.averageTurnaroundTime << std::setw(12) << m.averageWaitTime
+                  << std::setw(12) << m.averageResponseTime << "\n";
+    }
+
+    // histograms merge exactly, so the percentiles of a scheduler cover every process of all its runs
+    std::map<std::string, LatencyHistograms> byScheduler;
+    for (const auto& run : runs) {
+        if (run.ok) byScheduler[run.scheduler].merge(run.metrics.latency);
+    }
+    for (const auto& scheduler : byScheduler) {
+        std::cout << "\n" << scheduler.first << " over all runs:\n";
+        printPercentiles("Turnaround Time", scheduler.second.turnaround);
+        printPercentiles("Wait Time", scheduler.second.wait);
+        printPercentiles("Response Time", scheduler.second.response);
+        printPercentiles("I/O Time", scheduler.second.io);
+    }
+
+    csv.close();
+    return !csv.fail();
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> inputs;
+    std::vector<std::string> schedulers = {"FCFS", "EP", "RR"};
+    std::vector<unsigned int> quanta = {100};
+    std::vector<std::string> layouts = {"default"};
+    unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string outputDir = ".";
+    bool eventDriven = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--event-driven") {
+            eventDriven = true;
+            continue;
+        }
+        if (i + 1 >= argc) break;
+        std::vector<std::string> values = utils::split_delim(argv[++i], ",");
+        if (arg == "--inputs") {
+            inputs = values;
+        } else if (arg == "--schedulers") {
+            schedulers = values;
+        } else if (arg == "--quanta") {
+            quanta.clear();
+            for (const auto& value : values) quanta.push_back(std::stoi(value));
+        } else if (arg == "--partitions") {
+            layouts = values;
+        } else if (arg == "--threads") {
+            threads = std::max(1, std::stoi(values[0]));
+        } else if (arg == "--output-dir") {
+            outputDir = values[0];
+        }
+    }
+
+    if (inputs.empty()) {
+        std::cerr << "Usage: " << argv[0] << " --inputs a.txt,b.txt [--schedulers FCFS,EP,RR] [--quanta 50,100]\n"
+                  << "       [--partitions default,layout.txt] [--threads n] [--output-dir dir] [--event-driven]\n";
+        return 1;
+    }
+
+    if (mkdir(outputDir.c_str(), 0777) != 0 && errno != EEXIST) {
+        std::cerr << "Could not create " << outputDir << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+
+    // one run per (input, scheduler, quantum, partition layout), the quantum only matters for RR
+    std::vector<SweepRun> runs;
+    // the input index keeps inputs with the same base name from sharing output files
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const std::string& input = inputs[i];
+        for (const auto& scheduler : schedulers) {
+            for (size_t q = 0; q < quanta.size(); q++) {
+                if (scheduler != "RR" && q > 0) break;
+                for (size_t l = 0; l < layouts.size(); l++) {
+                    SweepRun run;
+                    run.input = input;
+                    run.scheduler = scheduler;
+                    run.quantum = quanta[q];
+                    run.partitions = layouts[l];
+                    run.name = baseName(input) + "_i" + std::to_string(i) + "_" + scheduler + (scheduler == "RR" ? "_q" + std::to_string(quanta[q]) : "")
+                               + "_p" + std::to_string(l);
+                    run.ok = false;
+                    run.seconds = 0;
+                    runs.push_back(run);
+                }
+            }
+        }
+    }
+
+    // worker threads take the next run until none are left
+    std::atomic<size_t> nextRun(0);
+    std::mutex progressMutex;
+    size_t finished = 0;
+    auto worker = [&]() {
+        for (size_t i = nextRun++; i < runs.size(); i = nextRun++) {
+            runOne(runs[i], outputDir, eventDriven);
+            std::lock_guard<std::mutex> lock(progressMutex);
+            std::cerr << "[" << ++finished << "/" << runs.size() << "] " << runs[i].name
+                      << (runs[i].ok ? "" : " failed") << "\n";
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned int t = 0; t < std::min<size_t>(threads, runs.size()); t++) {
+        pool.push_back(std::thread(worker));
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::string csvFile = outputDir + "/sweep_metrics.csv";
+    bool written = reportRuns(runs, csvFile);
+    size_t failed = std::count_if(runs.begin(), runs.end(), [](const SweepRun& run) { return !run.ok; });
+    std::cout << "\n" << runs.size() << " runs on " << pool.size() << " threads in " << seconds << " s";
+    if (failed > 0) std::cout << ", " << failed << " failed";
+    if (written) {
+        std::cout << ", metrics written to " << csvFile << "\n";
+    } else {
+        std::cout << "\n";
+        std::cerr << "Could not write " << csvFile << "\n";
+    }
+    return written && failed == 0 ? 0 : 1;
+}
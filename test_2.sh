@@ -1,6 +1,6 @@
 #!/bin/bash
 
-g++ -std=c++11 interrupts_101206884_101211245.cpp -o simulator
+g++ -std=c++11 -pthread interrupts_101206884_101211245.cpp -o simulator
 
 # run the simulator with FCFS scheduler
 ./simulator input_data_2.txt EP
@@ -0,0 +1,33 @@
+#!/bin/bash
+
+g++ -std=c++11 -pthread interrupts_101206884_101211245.cpp -o simulator
+g++ -std=c++11 -pthread trace_convert_101206884_101211245.cpp -o trace_convert
+
+# a partition table loaded while dynamic memory is on must not disturb the dynamic memory log
+echo "40, 25, 15, 10, 8, 2" > partitions_check.txt
+
+# the binary traces must convert back to exactly the text tables, with the partition table and with dynamic memory
+status=0
+for memory in "" "--memory 100 --compaction-cost 0.5" "--memory 100 --partitions partitions_check.txt"; do
+    if ! ./simulator input_data_2.txt RR $memory > /dev/null; then
+        echo "simulator FAILED: RR $memory"
+        status=1
+        continue
+    fi
+    mv execution.txt execution_text.txt
+    mv memory_status.txt memory_status_text.txt
+
+    ./simulator input_data_2.txt RR $memory --binary-trace > /dev/null
+    ./trace_convert execution.bin execution_converted.txt
+    ./trace_convert memory_status.bin memory_status_converted.txt
+
+    if cmp -s execution_text.txt execution_converted.txt && cmp -s memory_status_text.txt memory_status_converted.txt; then
+        echo "round trip ok: RR $memory"
+    else
+        echo "round trip FAILED: RR $memory"
+        status=1
+    fi
+done
+
+rm -f partitions_check.txt execution_text.txt execution_converted.txt memory_status_text.txt memory_status_converted.txt
+exit $status
@@ -0,0 +1,33 @@
+#!/bin/bash
+
+g++ -std=c++11 -pthread interrupts_101206884_101211245.cpp -o simulator
+g++ -std=c++11 -O2 -pthread workload_generator_101206884_101211245.cpp -o workload_generator
+
+# the init.sh inputs, plus a generated workload whose long bursts leave many idle ticks to skip
+inputs=$(mktemp -d)
+(cd "$inputs" && sh "$OLDPWD/init.sh" > /dev/null)
+./workload_generator "$inputs/input_data_generated.txt" --count 2000 --seed 7 > /dev/null
+
+# the event driven engine must write exactly the tables of the tick loop
+status=0
+for input in "$inputs"/input_data_*.txt; do
+    for scheduler in FCFS EP RR SJF SRTF MLFQ CFS; do
+        for options in "" "--cores 3" "--memory 100 --compaction-cost 0.5"; do
+            ./simulator $input $scheduler $options > /dev/null 2>&1
+            mv execution.txt execution_tick.txt
+            mv memory_status.txt memory_status_tick.txt
+
+            ./simulator $input $scheduler $options --event-driven > /dev/null 2>&1
+            if cmp -s execution.txt execution_tick.txt && cmp -s memory_status.txt memory_status_tick.txt; then
+                echo "engines match: $(basename $input) $scheduler $options"
+            else
+                echo "engines DIFFER: $(basename $input) $scheduler $options"
+                status=1
+            fi
+        done
+    done
+done
+
+rm -rf "$inputs"
+rm -f execution_tick.txt memory_status_tick.txt
+exit $status
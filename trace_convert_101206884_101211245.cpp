@@ -0,0 +1,96 @@
+#define SIMULATOR_NO_MAIN
+#include "interrupts_101206884_101211245.cpp"
+
+// renders a binary execution trace as the execution table
+bool convertExecution(std::ifstream& in, const TraceFileHeader& header, TraceWriter& out) {
+    if (header.recordSize != sizeof(TransitionRecord)) return false;
+
+    tables::writeExecutionHeader(out);
+    TransitionRecord record;
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        tables::writeExecutionRow(out, record.time, record.pid,
+                                  static_cast<ProcessState>(record.oldState), static_cast<ProcessState>(record.newState));
+    }
+    tables::writeExecutionFooter(out);
+    return true;
+}
+
+// renders a binary memory trace as the memory status table
+bool convertMemoryStatus(std::ifstream& in, const TraceFileHeader& header, TraceWriter& out) {
+    if (header.recordSize != sizeof(MemoryStatusRecord) + header.partitionCount * sizeof(int32_t)) return false;
+
+    // partition sizes are not needed to render the table
+    in.seekg(header.partitionCount * sizeof(uint32_t), std::ios::cur);
+
+    bool started = false;
+    MemoryStatusRecord record;
+    std::vector<int> partitionsState(header.partitionCount);
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(record)) &&
+           in.read(reinterpret_cast<char*>(partitionsState.data()), partitionsState.size() * sizeof(int32_t))) {
+        if (!started) {
+            tables::writeMemoryStatusHeader(out);
+            started = true;
+        }
+        tables::writeMemoryStatusRow(out, record.time, record.memoryUsed, partitionsState,
+                                     record.totalFreeMemory, record.usableFreeMemory);
+    }
+    tables::writeMemoryStatusFooter(out);
+    return true;
+}
+
+// renders a binary dynamic memory trace, whose records list their blocks, as the memory status table
+bool convertBlockMemoryStatus(std::ifstream& in, const TraceFileHeader& header, TraceWriter& out) {
+    if (header.recordSize != sizeof(MemoryStatusRecord) || header.partitionCount != 0) return false;
+
+    bool started = false;
+    MemoryStatusRecord record;
+    uint32_t blockCount;
+    std::vector<int> blocksState;
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(record)) &&
+           in.read(reinterpret_cast<char*>(&blockCount), sizeof(blockCount))) {
+        blocksState.resize(blockCount);
+        if (!in.read(reinterpret_cast<char*>(blocksState.data()), blocksState.size() * sizeof(int32_t))) break;
+        if (!started) {
+            tables::writeMemoryStatusHeader(out);
+            started = true;
+        }
+        tables::writeMemoryStatusRow(out, record.time, record.memoryUsed, blocksState,
+                                     record.totalFreeMemory, record.usableFreeMemory);
+    }
+    tables::writeMemoryStatusFooter(out);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <trace.bin> <table.txt>\n";
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    TraceFileHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        std::cerr << "Could not read trace header from " << argv[1] << "\n";
+        return 1;
+    }
+
+    TraceWriter out;
+    if (!out.open(argv[2])) {
+        std::cerr << "Could not open " << argv[2] << "\n";
+        return 1;
+    }
+
+    bool converted = false;
+    if (std::memcmp(header.magic, EXECUTION_TRACE_MAGIC, sizeof(header.magic)) == 0) {
+        converted = convertExecution(in, header, out);
+    } else if (std::memcmp(header.magic, MEMORY_TRACE_MAGIC, sizeof(header.magic)) == 0) {
+        converted = convertMemoryStatus(in, header, out);
+    } else if (std::memcmp(header.magic, BLOCK_MEMORY_TRACE_MAGIC, sizeof(header.magic)) == 0) {
+        converted = convertBlockMemoryStatus(in, header, out);
+    }
+    if (!converted) {
+        std::cerr << argv[1] << " is not a valid binary trace\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+#define SIMULATOR_NO_MAIN
+#include "interrupts_101206884_101211245.cpp"
+
+#include <cmath>
+
+struct GeneratorConfig {
+    unsigned long count;               // number of processes to generate
+    unsigned long seed;                // random seed, the same seed always gives the same file
+    double arrivalRate;                // mean arrivals per ms, arrivals are a poisson process
+    std::string cpuDistribution;       // "exp" for exponential or "pareto" for heavy tailed cpu bursts
+    double cpuMean;                    // mean cpu time in ms
+    double paretoAlpha;                // tail index of the pareto distribution, must be above 1
+    double ioFrequencyMean;            // mean cpu time between io operations in ms
+    double ioDurationMean;             // mean duration of an io operation in ms
+    unsigned int priorityLevels;       // priorities are drawn from [0, priorityLevels), 0 omits the column
+    std::vector<unsigned int> partitionSizes; // sizes are drawn so every process fits one of these partitions
+};
+
+// draws a value from an exponential or pareto distribution with the given mean
+double drawBurst(std::mt19937_64& gen, const std::string& distribution, double mean, double alpha) {
+    if (distribution == "pareto") {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        double scale = mean * (alpha - 1) / alpha;
+        return scale / std::pow(1.0 - uniform(gen), 1.0 / alpha);
+    }
+    std::exponential_distribution<double> exponential(1.0 / mean);
+    return exponential(gen);
+}
+
+// rounds a drawn time to a field value the simulator accepts, at least 1 ms
+unsigned int toField(double value) {
+    if (value < 1) return 1;
+    if (value > INT_MAX) return INT_MAX;
+    return static_cast<unsigned int>(value);
+}
+
+// writes count processes in the input_data format
+void generate(const GeneratorConfig& config, TraceWriter& out) {
+    std::mt19937_64 gen(config.seed);
+    std::exponential_distribution<double> interArrival(config.arrivalRate);
+    std::uniform_int_distribution<size_t> partitionDistr(0, config.partitionSizes.size() - 1);
+    std::uniform_int_distribution<unsigned int> priorityDistr(0, config.priorityLevels > 0 ? config.priorityLevels - 1 : 0);
+
+    // a process targeting a partition is bigger than the next smaller partition, so the size mix follows the table
+    std::vector<unsigned int> sorted = config.partitionSizes;
+    std::sort(sorted.begin(), sorted.end());
+
+    double clock = 0;
+    for (unsigned long pid = 1; pid <= config.count; pid++) {
+        unsigned int arrival = clock < INT_MAX ? static_cast<unsigned int>(clock) : INT_MAX;
+        clock += interArrival(gen);
+
+        size_t target = partitionDistr(gen);
+        auto position = std::lower_bound(sorted.begin(), sorted.end(), config.partitionSizes[target]);
+        unsigned int lower = position == sorted.begin() ? 1 : std::min(*(position - 1) + 1, *position);
+        unsigned int size = std::uniform_int_distribution<unsigned int>(lower, *position)(gen);
+
+        unsigned int cpu = toField(drawBurst(gen, config.cpuDistribution, config.cpuMean, config.paretoAlpha));
+        unsigned int ioFrequency = toField(drawBurst(gen, "exp", config.ioFrequencyMean, 0));
+        unsigned int ioDuration = toField(drawBurst(gen, "exp", config.ioDurationMean, 0));
+
+        const size_t maxRowLength = 96;
+        char* row = out.reserve(maxRowLength);
+        int length;
+        if (config.priorityLevels > 0) {
+            length = std::snprintf(row, maxRowLength, "%lu, %u, %u, %u, %u, %u, %u\n",
+                                   pid, size, arrival, cpu, ioFrequency, ioDuration, priorityDistr(gen));
+        } else {
+            length = std::snprintf(row, maxRowLength, "%lu, %u, %u, %u, %u, %u\n",
+                                   pid, size, arrival, cpu, ioFrequency, ioDuration);
+        }
+        out.commit(length);
+    }
+}
+
+// reads partition sizes in the same format as the simulator's --partitions option
+bool loadPartitionSizes(const std::string& filename, std::vector<unsigned int>& sizes) {
+    std::ifstream file(filename);
+    if (!file) return false;
+
+    sizes.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        for (const auto& part : utils::split_delim(line, ",")) {
+            std::string token = utils::trim(part);
+            if (token.empty()) continue;
+            sizes.push_back(std::stoi(token));
+        }
+    }
+    return !sizes.empty();
+}
+
+// prints the command line options
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " <output.txt> [--count n] [--seed s] [--arrival-rate per_ms]\n"
+              << "       [--cpu exp|pareto] [--cpu-mean ms] [--pareto-alpha a] [--io-frequency-mean ms]\n"
+              << "       [--io-duration-mean ms] [--priorities levels] [--partitions <file>]\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    GeneratorConfig config;
+    config.count = 1000;
+    config.seed = 1;
+    config.arrivalRate = 0.01;
+    config.cpuDistribution = "exp";
+    config.cpuMean = 1000;
+    config.paretoAlpha = 1.5;
+    config.ioFrequencyMean = 100;
+    config.ioDurationMean = 20;
+    config.priorityLevels = 10;
+    config.partitionSizes = {40, 25, 15, 10, 8, 2};
+
+    for (int i = 2; i < argc; i += 2) {
+        std::string arg = argv[i];
+        if (i + 1 == argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[i + 1];
+        if (arg == "--count") {
+            config.count = std::stoul(value);
+        } else if (arg == "--seed") {
+            config.seed = std::stoul(value);
+        } else if (arg == "--arrival-rate") {
+            config.arrivalRate = std::stod(value);
+        } else if (arg == "--cpu") {
+            config.cpuDistribution = value;
+        } else if (arg == "--cpu-mean") {
+            config.cpuMean = std::stod(value);
+        } else if (arg == "--pareto-alpha") {
+            config.paretoAlpha = std::stod(value);
+        } else if (arg == "--io-frequency-mean") {
+            config.ioFrequencyMean = std::stod(value);
+        } else if (arg == "--io-duration-mean") {
+            config.ioDurationMean = std::stod(value);
+        } else if (arg == "--priorities") {
+            config.priorityLevels = std::stoul(value);
+        } else if (arg == "--partitions") {
+            if (!loadPartitionSizes(value, config.partitionSizes)) {
+                std::cerr << "Could not load partitions from " << value << "\n";
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown option " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (config.arrivalRate <= 0 || config.cpuMean <= 0 || config.ioFrequencyMean <= 0 || config.ioDurationMean <= 0) {
+        std::cerr << "Rates and means must be positive\n";
+        return 1;
+    }
+    if (config.cpuDistribution != "exp" && config.cpuDistribution != "pareto") {
+        std::cerr << "Unknown cpu distribution " << config.cpuDistribution << "\n";
+        return 1;
+    }
+    if (config.cpuDistribution == "pareto" && config.paretoAlpha <= 1) {
+        std::cerr << "The pareto alpha must be above 1 for the mean to exist\n";
+        return 1;
+    }
+
+    TraceWriter out;
+    if (!out.open(argv[1])) {
+        std::cerr << "Could not open " << argv[1] << "\n";
+        return 1;
+    }
+    generate(config, out);
+    return 0;
+}